@@ -4,6 +4,7 @@
 ---@field Scancode sol.Scancode
 ---@field BodyType sol.BodyType
 ---@field BodyShapeType sol.BodyShapeType
+---@field ContactType sol.ContactType
 ---@field keyboard sol.Keyboard
 ---@field mouse sol.Mouse
 ---@field stores sol.StoreManager
@@ -43,9 +44,20 @@ script = nil
 ---@field b integer
 ---@field a integer?
 
+---@class sol.TextureMemoryStats
+---@field budget integer
+---@field residentBytes integer
+---@field residentCount integer
+---@field evictedCount integer
+---@field totalEvictions integer
+---@field totalReloads integer
+
 ---@class sol.SceneOptions
 ---@field metersPerPixel number?
 ---@field gravity sol.Point?
+---@field physicsWorkerCount integer? default: the "workers" attribute of <physics> in game.xml, 0 - one per CPU core
+---@field pathWorkerCount integer? threads searching the requested paths, default 1
+---@field pathCompletionBudget integer? completed path requests dispatched per step, default 8, 0 - unlimited
 
 ---@class SpriteOptions
 ---@field colorToAlpha sol.Color?
@@ -79,12 +91,33 @@ script = nil
 ---@field friction number?
 ---@field isSensor boolean?
 ---@field isPreSolveEnabled boolean?
+---@field tag string?
+---@field collisionFilter sol.CollisionFilter?
+
+---Categories must be declared in the scene before bodies are created.
+---Tiled objects can override the filter with the properties
+---collisionCategories and collisionMask (comma-separated names) and collisionGroup.
+---@class sol.CollisionFilter
+---@field categories string[]?
+---@field mask string[]?
+---@field group integer?
 
 ---@class sol.BodyOptions
 ---@field type integer?
 ---@field shapeKey string?
 ---@field bodyPhysics sol.BodyPhysicsDefinition?
 ---@field shapePhysics sol.BodyShapePhysicsDefinition?
+---@field merge boolean? static objects of each object layer become shapes of a single body, the object IDs are appended to the shape keys after "#"
+---@field chainOutlines boolean? polygons become one-sided chain loops that collide from outside
+---@field mergeRectangles boolean? adjacent rectangles of the merged bodies are merged
+---@see sol.BodyType
+
+---@alias sol.BodyPrototype integer | string
+
+---@class sol.BodyPrototypeOverrides
+---@field type integer?
+---@field layer string?
+---@field linearVelocity sol.Point?
 ---@see sol.BodyType
 
 ---@class sol.BodyDefinition
@@ -247,6 +280,9 @@ function __window:setView(view) end
 ---@return sol.View?
 function __window:getView() end
 
+---@return sol.TextureMemoryStats
+function __window:getTextureMemoryStats() end
+
 ---@class sol.View
 local __view
 
@@ -281,6 +317,29 @@ function __scene:setBackgroundColor(color) end
 ---@param vector sol.Point
 function __scene:setGravity(vector) end
 
+---Declares a named collision category. The "default" category is declared implicitly.
+---@param name string
+---@return boolean
+function __scene:declareCollisionCategory(name) end
+
+---Contacts of shapes with the tag are kept only if the other shape comes from the normal direction
+---@param tag string
+---@param normal sol.Point
+function __scene:setOneWayNormal(tag, normal) end
+
+---@param tag string
+---@return boolean
+function __scene:removeOneWayNormal(tag) end
+
+---@param tag_a string
+---@param tag_b string
+function __scene:ignoreTagContacts(tag_a, tag_b) end
+
+---@param tag_a string
+---@param tag_b string
+---@return boolean
+function __scene:restoreTagContacts(tag_a, tag_b) end
+
 ---@param path string
 ---@return boolean
 function __scene:loadTileMap(path) end
@@ -304,6 +363,27 @@ function __scene:getTileMapObjectsByClass(class) end
 ---@return sol.Body
 function __scene:createBody(position, definition, script_path, script_argument) end
 
+---@param definition sol.BodyDefinition
+---@param positions sol.Point[]
+---@return integer[]
+function __scene:createBodies(definition, positions) end
+
+---@param name string
+---@param definition sol.BodyDefinition
+---@return integer
+function __scene:createBodyPrototype(name, definition) end
+
+---@param name string
+---@return integer | nil
+function __scene:getBodyPrototype(name) end
+
+---@param prototype sol.BodyPrototype
+---@param position sol.Point?
+---@param overrides sol.BodyPrototypeOverrides?
+---@return sol.Body | nil
+function __scene:createBodyFromPrototype(prototype, position, overrides) end
+
+---The body becomes invalid immediately, but it is removed from the physical world at the beginning of the next step
 ---@param body integer | sol.Body
 ---@return boolean
 function __scene:destroyBody(body) end
@@ -312,10 +392,35 @@ function __scene:destroyBody(body) end
 ---@return sol.Body | nil
 function __scene:getBody(body_id) end
 
+---Polylines become one-sided chains: a polyline drawn from left to right collides on its upper side.
+---Polygons with more than 8 vertices become chain loops
 ---@param class string
 ---@param body_options sol.BodyOptions?
 function __scene:createBodiesFromMapObjects(class, body_options) end
 
+---Builds static bodies from the collision shapes defined for the tiles in the tileset.
+---Rectangles are merged, the layer is split into chunks of 16x16 tiles with a body per chunk.
+---Only the shape physics, the body physics and the shape key are taken from the options
+---@param layer_name string
+---@param body_options sol.BodyOptions?
+---@return boolean false if there is no tile layer with this name
+function __scene:createBodiesFromTileLayer(layer_name, body_options) end
+
+---Rebuilds the collision of the chunk if the layer has it
+---@param layer_name string
+---@param x integer
+---@param y integer
+---@param tile_gid integer
+---@return boolean
+function __scene:setTile(layer_name, x, y, tile_gid) end
+
+---Rebuilds the collision of the chunk if the layer has it
+---@param layer_name string
+---@param x integer
+---@param y integer
+---@return boolean
+function __scene:eraseTile(layer_name, x, y) end
+
 ---@param body integer | sol.Body
 ---@return boolean
 function __scene:setFollowedBody(body) end
@@ -325,8 +430,23 @@ function __scene:resetFollowedBody() end
 ---@alias sol.ContactCallback fun(contact: sol.Contact)
 ---@alias sol.SensorContactCallback fun(contact: sol.SensorContact)
 ---@alias sol.PreSolveContactCallback fun(contact: sol.PreSolveContact)
+---@alias sol.ContactsCallback fun(contacts: sol.ContactRecord[], count: integer)
 ---@alias sol.StepCallback fun(time_passed: integer)
 
+---@alias sol.AnimationCallback fun(body_id: integer, shape_key: string, frame_index: integer)
+---@alias sol.PathCallback fun(request_id: integer, points: sol.Point[] | false, is_complete: boolean)
+---@alias sol.BodyActivityCallback fun(body_id: integer, is_active: boolean)
+
+---@param callback sol.ContactsCallback
+---@param filter sol.ContactFilter?
+---@return integer subscription ID
+---The callback is called once per step with all the matching contacts.
+---The contacts array and its records are reused between steps, do not keep references to them.
+function __scene:subscribeToContacts(callback, filter) end
+
+---@param subscription_id integer
+function __scene:unsubscribeFromContacts(subscription_id) end
+
 ---@param callback sol.ContactCallback
 ---@return integer subscription ID
 function __scene:subscribeToBeginContact(callback) end
@@ -369,6 +489,28 @@ function __scene:subscribeToStep(callback) end
 ---@param subscription_id integer
 function __scene:unsubscribeFromStep(subscription_id) end
 
+---The callback is called when a body is disabled or enabled by the activity region
+---@param callback sol.BodyActivityCallback
+---@return integer subscription ID
+function __scene:subscribeToBodyActivity(callback) end
+
+---@param subscription_id integer
+function __scene:unsubscribeFromBodyActivity(subscription_id) end
+
+---@param callback sol.AnimationCallback
+---@return integer subscription ID
+function __scene:subscribeToAnimationFrameChange(callback) end
+
+---@param subscription_id integer
+function __scene:unsubscribeFromAnimationFrameChange(subscription_id) end
+
+---@param callback sol.AnimationCallback
+---@return integer subscription ID
+function __scene:subscribeToAnimationLoopEnd(callback) end
+
+---@param subscription_id integer
+function __scene:unsubscribeFromAnimationLoopEnd(subscription_id) end
+
 ---@param definition sol.DistanceJointDefenition
 ---@return sol.DistanceJoint
 function __scene:createDistanceJoint(definition) end
@@ -421,10 +563,155 @@ function __scene:getWheelJoint(id) end
 ---@return boolean
 function __scene:destroyJoint(joint) end
 
+---Saves gravity, body transforms, velocities, sleep state, animation playback state and joint parameters
+---to a binary string
+---@return string
+function __scene:snapshot() end
+
+---Applies a snapshot to the bodies and joints that still exist, destroyed bodies are not recreated
+---@param snapshot string
+---@return integer | nil # number of restored bodies or nil if the snapshot is malformed
+function __scene:restore(snapshot) end
+
+---Only static bodies are treated as obstacles
 ---@param body_id integer | sol.Body
 ---@param destination sol.Point
----@return sol.Point[] | nil
-function __scene:findPath(body_id, destination) end
+---@param options sol.PathOptions?
+---@return sol.Point[] | false points false if the path is not found or the body does not exist
+---@return boolean is_complete false if the path leads to the closest reachable point
+function __scene:findPath(body_id, destination, options) end
+
+---Searches the path on a worker thread against a snapshot of the static bodies.
+---The result is passed to the callback or kept until it is taken by takePathResult
+---@param body_id integer | sol.Body
+---@param destination sol.Point
+---@param options sol.PathOptions?
+---@param callback sol.PathCallback?
+---@return integer | nil request_id nil if the body does not exist
+function __scene:requestPath(body_id, destination, options, callback) end
+
+---Returns nil if the path is not ready yet, false if the path is not found
+---@param request_id integer
+---@return sol.Point[] | false | nil
+---@return boolean is_complete
+function __scene:takePathResult(request_id) end
+
+---Cancels the request or discards its result
+---@param request_id integer
+---@return boolean
+function __scene:cancelPathRequest(request_id) end
+
+---Builds a direction field towards the goal shared by any number of bodies.
+---The field is rebuilt automatically when static bodies change
+---@param goal sol.Point
+---@param options sol.FlowFieldOptions?
+---@return integer | nil flow_field_id nil if neither the area nor the cell size is known
+function __scene:createFlowField(goal, options) end
+
+---@param flow_field_id integer
+---@param goal sol.Point
+---@return boolean
+function __scene:setFlowFieldGoal(flow_field_id, goal) end
+
+---Returns the unit direction to the next cell, zero in the goal cell,
+---or nil if the point is outside the field or cannot reach the goal
+---@param flow_field_id integer
+---@param point sol.Point
+---@return sol.Point | nil
+function __scene:getFlowDirection(flow_field_id, point) end
+
+---Sets the linear velocity of each body along the field
+---@param flow_field_id integer
+---@param bodies (integer | sol.Body)[]
+---@param speed number
+---@return integer count of the bodies whose velocity has been changed
+function __scene:applyFlowField(flow_field_id, bodies, speed) end
+
+---@param flow_field_id integer
+---@return boolean
+function __scene:destroyFlowField(flow_field_id) end
+
+---Non-static bodies outside the visible area and the squares around the focus bodies are disabled
+---at the beginning of each step and enabled again when they come back. Nil removes the region and enables all bodies
+---@param options sol.ActivityRegionOptions?
+function __scene:setActivityRegion(options) end
+
+---@param body integer | sol.Body
+---@return boolean
+function __scene:addActivityFocus(body) end
+
+---@param body integer | sol.Body
+---@return boolean
+function __scene:removeActivityFocus(body) end
+
+---@param body integer | sol.Body
+---@return boolean | nil
+function __scene:isBodyActive(body) end
+
+---Returns the closest hit for each ray or false if the ray hits nothing.
+---Points are in meters as positions of bodies
+---@param rays sol.RayCast[]
+---@param options sol.QueryOptions?
+---@return (sol.QueryHit | false)[]
+function __scene:castRays(rays, options) end
+
+---Returns the closest hit for each cast or false if the shape hits nothing.
+---Points are in meters as positions of bodies, radius and size are in pixels as sizes of body shapes
+---@param casts sol.ShapeCast[]
+---@param options sol.QueryOptions?
+---@return (sol.QueryHit | false)[]
+function __scene:castShapes(casts, options) end
+
+---Returns IDs of the bodies overlapping each rectangle.
+---x and y of the top left corner are in meters, width and height are in pixels as sizes of body shapes
+---@param rects sol.Rectangle[]
+---@param options sol.QueryOptions?
+---@return integer[][]
+function __scene:overlapRects(rects, options) end
+
+---@class sol.RayCast
+---@field from sol.Point
+---@field to sol.Point
+
+---Either radius or size must be set.
+---A circle is centered at the point, a rectangle is anchored at its top left corner as in overlapRects
+---@class sol.ShapeCast
+---@field from sol.Point
+---@field to sol.Point
+---@field radius number?
+---@field size sol.Size?
+
+---@class sol.QueryOptions
+---@field filter sol.CollisionFilter?
+---@field isParallel boolean? runs the queries on the physics worker threads
+
+---@class sol.PathOptions
+---@field allowDiagonalSteps boolean?
+---@field avoidSensors boolean?
+---@field allowPartialPath boolean? returns the path to the closest reachable point if the destination is unreachable
+---@field hierarchical boolean? searches over the precomputed clusters first, faster for long routes but the path may be slightly longer
+---@field maxExpansions integer? 10000 by default, must be positive. Abstract nodes are counted for the hierarchical search
+
+---Distances are in pixels
+---@class sol.ActivityRegionOptions
+---@field cameraMargin number?
+---@field focusRadius number? half of the side of the square around each focus body
+---@field hysteresis number? how far a body has to leave the region to be disabled
+
+---@class sol.FlowFieldOptions
+---@field area sol.Rectangle? in meters like body positions, the tile map bounds by default
+---@field cellSize sol.Size? in meters, the tile size by default
+---@field allowDiagonalSteps boolean? true by default
+---@field avoidSensors boolean?
+
+---@class sol.QueryHit
+---@field bodyId integer
+---@field shapeKey string
+---@field x number
+---@field y number
+---@field normalX number
+---@field normalY number
+---@field fraction number
 
 ---@class sol.Body
 local __body
@@ -995,6 +1282,25 @@ function __button:unsubscribeOnClick(subscription_id) end
 ---@field bodyId integer
 ---@field shapeKey string
 ---@field tileMapObjectId integer?
+---@field tag string?
+
+---@class sol.ContactFilter
+---@field bodyId integer?
+---@field shapeKey string?
+---@field tag string?
+
+---For sensor contacts the side A is the sensor and the side B is the visitor
+---@class sol.ContactRecord
+---@field type integer
+---@field bodyIdA integer
+---@field shapeKeyA string
+---@field tileMapObjectIdA integer?
+---@field tagA string?
+---@field bodyIdB integer
+---@field shapeKeyB string
+---@field tileMapObjectIdB integer?
+---@field tagB string?
+---@see sol.ContactType
 
 ---@class sol.Store
 local __store
@@ -1206,6 +1512,12 @@ function __graphics_pack:removeSprite(frame_index, sprite_index) end
 ---@field DYNAMIC integer
 ---@field KINEMATIC integer
 
+---@class sol.ContactType
+---@field BEGIN integer
+---@field END integer
+---@field SENSOR_BEGIN integer
+---@field SENSOR_END integer
+
 ---@class sol.Scancode
 ---@field RIGHT_ARROW integer
 ---@field LEFT_ARROW integer
@@ -34,7 +34,7 @@ end
 skeleton:setPosition(Def.pixelPointToPhisical(points[script.arg.startPoint]))
 
 local path = scene:findPath(skeleton, points[3])
-if path == nil then
+if not path then
     print('Path not found');
     return
 end
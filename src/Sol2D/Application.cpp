@@ -87,7 +87,7 @@ Application::Application(const Workspace & _workspace) :
     m_step_state{},
     mp_sdl_window(nullptr),
     mp_device(nullptr),
-    mp_window(new Window)
+    mp_window(new Window(_workspace.getSceneWorkerCount()))
 {
     if(!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_GAMEPAD))
         throw SDLException("Unable to initialize SDL.");
@@ -126,6 +126,7 @@ void Application::exec()
 {
     ResourceManager resource_manager; // TODO: create in place
     Renderer renderer(resource_manager, mp_sdl_window, mp_device);
+    renderer.setTextureMemoryBudget(mr_workspace.getTextureMemoryBudget());
     StoreManager store_manager;
     std::unique_ptr<LuaLibrary> lua = std::make_unique<LuaLibrary>(mr_workspace, store_manager, *mp_window, renderer);
     lua->executeMainScript();
@@ -141,6 +142,7 @@ void Application::exec()
         if(passed_ticks >= render_frame_delay)
         {
             last_rendering_ticks = now_ticks;
+            ++m_step_state.frame;
             m_step_state.delta_time = std::chrono::milliseconds(passed_ticks);
             m_step_state.mouse_state.buttons = SDL_GetMouseState(
                 &m_step_state.mouse_state.position.x,
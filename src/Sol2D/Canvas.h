@@ -29,7 +29,8 @@ class Canvas : public Object
 public:
     Canvas() :
         m_rect{.0f, .0f, .0f, .0f},
-        m_clear_color{.0f, .0f, .0f, 1.0f}
+        m_clear_color{.0f, .0f, .0f, 1.0f},
+        m_revision(0)
     {
     }
 
@@ -38,18 +39,57 @@ public:
     void reconfigure(const SDL_FRect & _rect);
     float getWidth() const;
     float getHeight() const;
+    virtual bool update(const StepState & _state);
+    uint64_t getRevision() const;
+    virtual bool beginSimulation(const StepState & _state);
+    virtual void simulate(const StepState & _state);
     virtual void step(const StepState & _state) = 0;
     SDL_FPoint getTranslatedPoint(float _x, float _y) const;
     void translatePoint(float * _x, float * _y) const;
 
+protected:
+    void invalidate();
+
 private:
     SDL_FRect m_rect;
     SDL_FColor m_clear_color;
+    uint64_t m_revision;
 };
 
+// Called every step before the canvas is rendered.
+// Returns false if the canvas is redrawn only when its revision changes,
+// so every outlet can show its previous frame again until then.
+inline bool Canvas::update(const StepState & /*_state*/)
+{
+    return true;
+}
+
+inline uint64_t Canvas::getRevision() const
+{
+    return m_revision;
+}
+
+inline void Canvas::invalidate()
+{
+    ++m_revision;
+}
+
+// Called on the main thread before step when canvases are stepped concurrently.
+// Returns true if the canvas has work that simulate can do on a worker thread.
+inline bool Canvas::beginSimulation(const StepState & /*_state*/)
+{
+    return false;
+}
+
+// Called on a worker thread concurrently with other canvases, must not touch the renderer or scripts.
+inline void Canvas::simulate(const StepState & /*_state*/)
+{
+}
+
 inline void Canvas::setClearColor(const SDL_FColor & _color)
 {
     m_clear_color = _color;
+    invalidate();
 }
 
 inline const SDL_FColor & Canvas::getClearColor() const
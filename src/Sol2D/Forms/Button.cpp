@@ -24,10 +24,10 @@ Button::Button(const Canvas & _parent, const std::string & _text, Renderer & _re
 {
 }
 
-void Button::step(const StepState & _state)
+void Button::update(const StepState & _state)
 {
     handleState(_state);
-    Label::step(_state);
+    Label::update(_state);
 }
 
 void Button::handleState(const StepState & _state)
@@ -31,7 +31,7 @@ class Button : public Label, public Utils::Observable<ButtonClickObserver>
 {
 public:
     Button(const Canvas & _parent, const std::string & _text, Renderer & _renderer);
-    void step(const StepState & _state) override;
+    void update(const StepState & _state) override;
 
 private:
     void handleState(const StepState & _state);
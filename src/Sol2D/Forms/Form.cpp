@@ -23,6 +23,21 @@ Form::Form(Renderer & _renderer) :
 {
 }
 
+// Changes of the widgets are moved to the revision of the form, each outlet tracks the revision it has rendered
+bool Form::update(const StepState & _state)
+{
+    for(auto & widget : m_widgets)
+    {
+        widget->update(_state);
+        if(widget->isDirty())
+        {
+            widget->markClean();
+            invalidate();
+        }
+    }
+    return false;
+}
+
 void Form::step(const StepState & _state)
 {
     for(auto & widget : m_widgets)
@@ -33,6 +48,7 @@ std::shared_ptr<Label> Form::createLabel(const std::string & _text)
 {
     std::shared_ptr<Label> widget = std::make_shared<Label>(*this, _text, mr_renderer);
     m_widgets.push_back(widget);
+    invalidate();
     return widget;
 }
 
@@ -40,5 +56,6 @@ std::shared_ptr<Button> Form::createButton(const std::string & _text)
 {
     std::shared_ptr<Button> button = std::make_shared<Button>(*this, _text, mr_renderer);
     m_widgets.push_back(button);
+    invalidate();
     return button;
 }
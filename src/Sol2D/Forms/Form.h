@@ -27,6 +27,7 @@ class Form final : public Canvas
 {
 public:
     explicit Form(Renderer & _renderer);
+    bool update(const StepState & _state) override;
     void step(const StepState & _state) override;
     std::shared_ptr<Label> createLabel(const std::string & _text);
     std::shared_ptr<Button> createButton(const std::string & _text);
@@ -38,6 +38,7 @@ bool Label::setText(const std::string & _text)
     {
         m_text = _text;
         m_texture.reset();
+        markDirty();
         return true;
     }
     return false;
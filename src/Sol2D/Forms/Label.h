@@ -38,6 +38,7 @@ private:
         {
             if(mp_label->m_state == _state)
                 mp_label->m_texture.reset();
+            mp_label->markDirty();
         }
 
     private:
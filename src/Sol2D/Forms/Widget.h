@@ -28,6 +28,25 @@ class Widget : public Object
 {
     S2_DISABLE_COPY_AND_MOVE(Widget)
 
+private:
+    template<WidgetPropertyValueConcept PropertyType>
+    class Invalidator : public WidgetPropertyObserver<PropertyType>
+    {
+    public:
+        explicit Invalidator(Widget * _widget) :
+            mp_widget(_widget)
+        {
+        }
+
+        void onPropertyChanged(const WidgetProperty<PropertyType> &, WidgetState) override
+        {
+            mp_widget->markDirty();
+        }
+
+    private:
+        Widget * mp_widget;
+    };
+
 public:
     ~Widget() override;
     void setX(const Dimension<float> & _x);
@@ -38,9 +57,13 @@ public:
     const Dimension<float> & getWidth() const;
     void setHeight(const Dimension<float> & _height);
     const Dimension<float> & setHeight() const;
+    virtual void update(const StepState & _state);
     virtual void step(const StepState & _state);
     virtual bool setState(WidgetState _state);
     WidgetState getState() const;
+    bool isDirty() const;
+    void markDirty();
+    void markClean();
 
 public:
     WidgetProperty<std::shared_ptr<TTF_Font>> font;
@@ -57,6 +80,13 @@ protected:
 private:
     void renderBorder();
 
+private:
+    Invalidator<std::shared_ptr<TTF_Font>> m_font_invalidator;
+    Invalidator<SDL_FColor> m_color_invalidator;
+    Invalidator<float> m_float_invalidator;
+    Invalidator<WidgetPadding> m_padding_invalidator;
+    bool m_is_dirty;
+
 protected:
     const Canvas & mr_parent;
     Renderer & mr_renderer;
@@ -78,6 +108,11 @@ inline Widget::Widget(const Canvas & _parent, Renderer & _renderer):
     border_width(0),
     border_color(sc_default_border_color),
     padding(.0f),
+    m_font_invalidator(this),
+    m_color_invalidator(this),
+    m_float_invalidator(this),
+    m_padding_invalidator(this),
+    m_is_dirty(true),
     mr_parent(_parent),
     mr_renderer(_renderer),
     m_state(WidgetState::Default),
@@ -86,6 +121,12 @@ inline Widget::Widget(const Canvas & _parent, Renderer & _renderer):
     m_width(100.f, DimensionUnit::Percent),
     m_height(100.0f, DimensionUnit::Percent)
 {
+    font.addObserver(m_font_invalidator);
+    foreground_color.addObserver(m_color_invalidator);
+    background_color.addObserver(m_color_invalidator);
+    border_width.addObserver(m_float_invalidator);
+    border_color.addObserver(m_color_invalidator);
+    padding.addObserver(m_padding_invalidator);
 }
 
 inline Widget::~Widget()
@@ -100,6 +141,7 @@ inline const Canvas & Widget::getParent() const
 inline void Widget::setX(const Dimension<float> & _x)
 {
     m_x = _x;
+    m_is_dirty = true;
 }
 
 inline const Dimension<float> & Widget::getX() const
@@ -110,6 +152,7 @@ inline const Dimension<float> & Widget::getX() const
 inline void Widget::setY(const Dimension<float> & _y)
 {
     m_y = _y;
+    m_is_dirty = true;
 }
 
 inline const Dimension<float> & Widget::getY() const
@@ -120,6 +163,7 @@ inline const Dimension<float> & Widget::getY() const
 inline void Widget::setWidth(const Dimension<float> & _width)
 {
     m_width = _width;
+    m_is_dirty = true;
 }
 
 inline const Dimension<float> & Widget::getWidth() const
@@ -130,6 +174,7 @@ inline const Dimension<float> & Widget::getWidth() const
 inline void Widget::setHeight(const Dimension<float> & _height)
 {
     m_height = _height;
+    m_is_dirty = true;
 }
 
 inline const Dimension<float> & Widget::setHeight() const
@@ -142,6 +187,7 @@ inline bool Widget::setState(WidgetState _state)
     if(_state != m_state)
     {
         m_state = _state;
+        m_is_dirty = true;
         return true;
     }
     return false;
@@ -152,4 +198,23 @@ inline WidgetState Widget::getState() const
     return m_state;
 }
 
+inline void Widget::update(const StepState & /*_state*/)
+{
+}
+
+inline bool Widget::isDirty() const
+{
+    return m_is_dirty;
+}
+
+inline void Widget::markDirty()
+{
+    m_is_dirty = true;
+}
+
+inline void Widget::markClean()
+{
+    m_is_dirty = false;
+}
+
 } // namespace Sol2D::Forms
@@ -68,12 +68,10 @@ struct GraphicsPack::Frame
     explicit Frame(const GraphicsPackFrameDefinition & _definition);
     std::chrono::milliseconds duration;
     std::vector<Graphics> graphics;
-    bool is_visible;
 };
 
 GraphicsPack::Frame::Frame(const GraphicsPackFrameDefinition & _definition) :
-    duration(_definition.duration),
-    is_visible(_definition.is_visible)
+    duration(_definition.duration)
 {
     graphics.reserve(_definition.sprites.size());
     for(const auto & sprite_def : _definition.sprites)
@@ -87,6 +85,7 @@ GraphicsPack::GraphicsPack(
     mp_renderer(&_renderer),
     m_position(_definition.position),
     m_flip_mode(SDL_FLIP_NONE),
+    m_frames(std::make_shared<Frames>()),
     m_max_iterations(_definition.animation_iterations),
     m_current_iteration(0),
     m_current_frame_index(0),
@@ -97,128 +96,53 @@ GraphicsPack::GraphicsPack(
         m_flip_mode = static_cast<SDL_FlipMode>(static_cast<int>(m_flip_mode) | SDL_FLIP_HORIZONTAL);
     if(_definition.is_flipped_vertically)
         m_flip_mode = static_cast<SDL_FlipMode>(static_cast<int>(m_flip_mode) | SDL_FLIP_VERTICAL);
+    m_frames->reserve(_definition.frames.size());
+    m_frame_visibility.reserve(_definition.frames.size());
     for(const auto & frame_def : _definition.frames)
     {
         addFrame(frame_def);
     }
 }
 
-GraphicsPack::GraphicsPack(const GraphicsPack & _graphics_pack) :
-    mp_renderer(_graphics_pack.mp_renderer),
-    m_position(_graphics_pack.m_position),
-    m_flip_mode(_graphics_pack.m_flip_mode),
-    m_max_iterations(_graphics_pack.m_max_iterations),
-    m_current_iteration(0),
-    m_current_frame_index(_graphics_pack.m_current_frame_index),
-    m_current_frame_duration(_graphics_pack.m_current_frame_duration),
-    m_total_duration(_graphics_pack.m_total_duration)
-{
-    m_frames.reserve(_graphics_pack.m_frames.size());
-    for(auto * frame : _graphics_pack.m_frames)
-        m_frames.push_back(new Frame(*frame)); // cppcheck-suppress useStlAlgorithm
-}
-
-GraphicsPack::GraphicsPack(GraphicsPack && _graphics_pack) :
-    mp_renderer(_graphics_pack.mp_renderer),
-    m_position(_graphics_pack.m_position),
-    m_flip_mode(_graphics_pack.m_flip_mode),
-    m_frames(std::move(_graphics_pack.m_frames)),
-    m_max_iterations(_graphics_pack.m_max_iterations),
-    m_current_iteration(0),
-    m_current_frame_index(_graphics_pack.m_current_frame_index),
-    m_current_frame_duration(_graphics_pack.m_current_frame_duration),
-    m_total_duration(_graphics_pack.m_total_duration)
-{
-    _graphics_pack.mp_renderer = nullptr;
-    _graphics_pack.m_current_frame_duration = std::chrono::milliseconds::zero();
-    _graphics_pack.m_total_duration = std::chrono::milliseconds::zero();
-    _graphics_pack.m_current_frame_index = 0;
-}
-
-GraphicsPack::~GraphicsPack()
-{
-    destroy();
-}
-
-GraphicsPack & GraphicsPack::operator = (const GraphicsPack & _graphics_pack)
-{
-    if(this != &_graphics_pack)
-    {
-        destroy();
-        m_frames.reserve(_graphics_pack.m_frames.size());
-        for(auto * frame : _graphics_pack.m_frames)
-            m_frames.push_back(new Frame(*frame)); // cppcheck-suppress useStlAlgorithm
-        mp_renderer = _graphics_pack.mp_renderer;
-        m_flip_mode = _graphics_pack.m_flip_mode;
-        m_position = _graphics_pack.m_position;
-        m_max_iterations = _graphics_pack.m_max_iterations;
-        m_current_iteration = 0;
-        m_current_frame_index = _graphics_pack.m_current_frame_index;
-        m_current_frame_duration = _graphics_pack.m_current_frame_duration;
-        m_total_duration = _graphics_pack.m_total_duration;
-    }
-    return *this;
-}
-
-GraphicsPack & GraphicsPack::operator = (GraphicsPack && _graphics_pack)
-{
-    if(this != &_graphics_pack)
-    {
-        destroy();
-        m_frames.reserve(_graphics_pack.m_frames.size());
-        std::copy(_graphics_pack.m_frames.cbegin(), _graphics_pack.m_frames.cend(), m_frames.end());
-        _graphics_pack.m_frames.clear();
-        mp_renderer = _graphics_pack.mp_renderer;
-        _graphics_pack.mp_renderer = nullptr;
-        m_position = _graphics_pack.m_position;
-        m_flip_mode = _graphics_pack.m_flip_mode;
-        m_max_iterations = _graphics_pack.m_max_iterations;
-        m_current_iteration = 0;
-        m_current_frame_index = _graphics_pack.m_current_frame_index;
-        _graphics_pack.m_current_frame_index = 0;
-        m_current_frame_duration = _graphics_pack.m_current_frame_duration;
-        _graphics_pack.m_current_frame_duration = std::chrono::milliseconds::zero();
-        m_total_duration = _graphics_pack.m_total_duration;
-        _graphics_pack.m_total_duration = std::chrono::milliseconds::zero();
-    }
-    return *this;
-}
-
-void GraphicsPack::destroy()
+GraphicsPack::Frames & GraphicsPack::getWritableFrames()
 {
-    for(Frame * frame : m_frames)
-        delete frame;
-    m_frames.clear();
+    if(!m_frames)
+        m_frames = std::make_shared<Frames>();
+    else if(m_frames.use_count() > 1)
+        m_frames = std::make_shared<Frames>(*m_frames);
+    return *m_frames;
 }
 
 size_t GraphicsPack::addFrame(const GraphicsPackFrameDefinition & _definition)
 {
-    Frame * frame = new Frame(_definition);
-    m_frames.push_back(frame);
-    if(frame->is_visible)
-        m_total_duration += frame->duration;
-    return m_frames.size() - 1;
+    Frames & frames = getWritableFrames();
+    frames.emplace_back(_definition);
+    m_frame_visibility.push_back(_definition.is_visible);
+    if(_definition.is_visible)
+        m_total_duration += _definition.duration;
+    return frames.size() - 1;
 }
 
 size_t GraphicsPack::insertFrame(size_t _index, const GraphicsPackFrameDefinition & _definition)
 {
-    Frame * frame = new Frame(_definition);
-    m_frames.insert(m_frames.begin() + _index, frame);
-    if(frame->is_visible)
-        m_total_duration += frame->duration;
+    Frames & frames = getWritableFrames();
+    frames.emplace(frames.begin() + _index, _definition);
+    m_frame_visibility.insert(m_frame_visibility.begin() + _index, _definition.is_visible);
+    if(_definition.is_visible)
+        m_total_duration += _definition.duration;
     return _index;
 }
 
 bool GraphicsPack::removeFrame(size_t _index)
 {
-    auto it = m_frames.begin() + _index;
-    if(it == m_frames.end())
+    if(_index >= m_frame_visibility.size())
         return false;
-    const Frame * frame = *it;
-    if(frame->is_visible)
-        m_total_duration -= frame->duration;
-    m_frames.erase(it);
-    if(m_current_frame_index >= m_frames.size())
+    Frames & frames = getWritableFrames();
+    if(m_frame_visibility[_index])
+        m_total_duration -= frames[_index].duration;
+    frames.erase(frames.begin() + _index);
+    m_frame_visibility.erase(m_frame_visibility.begin() + _index);
+    if(m_current_frame_index >= frames.size())
     {
         m_current_frame_index = 0;
         m_current_frame_duration = std::chrono::milliseconds::zero();
@@ -228,18 +152,18 @@ bool GraphicsPack::removeFrame(size_t _index)
 
 bool GraphicsPack::setFrameVisibility(size_t _index, bool _is_visible)
 {
-    if(_index < m_frames.size())
+    if(_index < m_frame_visibility.size())
     {
-        Frame * frame = m_frames[_index];
-        if(frame->is_visible && !_is_visible)
+        const std::chrono::milliseconds duration = (*m_frames)[_index].duration;
+        if(m_frame_visibility[_index] && !_is_visible)
         {
-            m_total_duration -= frame->duration;
-            frame->is_visible = false;
+            m_total_duration -= duration;
+            m_frame_visibility[_index] = false;
         }
-        else if(!frame->is_visible && _is_visible)
+        else if(!m_frame_visibility[_index] && _is_visible)
         {
-            m_total_duration += frame->duration;
-            frame->is_visible = true;
+            m_total_duration += duration;
+            m_frame_visibility[_index] = true;
         }
         return true;
     }
@@ -248,19 +172,19 @@ bool GraphicsPack::setFrameVisibility(size_t _index, bool _is_visible)
 
 std::optional<bool> GraphicsPack::isFrameVisible(size_t _index) const
 {
-    if(_index < m_frames.size())
-        return m_frames[_index]->is_visible;
+    if(_index < m_frame_visibility.size())
+        return m_frame_visibility[_index];
     return std::nullopt;
 }
 
 bool GraphicsPack::setFrameDuration(size_t _index, std::chrono::milliseconds _duration)
 {
-    if(_index < m_frames.size())
+    if(_index < m_frame_visibility.size())
     {
-        Frame * frame = m_frames[_index];
-        if(frame->is_visible)
-            m_total_duration = m_total_duration - frame->duration + _duration;
-        frame->duration = _duration;
+        Frame & frame = getWritableFrames()[_index];
+        if(m_frame_visibility[_index])
+            m_total_duration = m_total_duration - frame.duration + _duration;
+        frame.duration = _duration;
         return true;
     }
     return false;
@@ -268,56 +192,59 @@ bool GraphicsPack::setFrameDuration(size_t _index, std::chrono::milliseconds _du
 
 std::optional<std::chrono::milliseconds> GraphicsPack::getFrameDuration(size_t _index) const
 {
-    if(_index < m_frames.size())
+    if(_index < m_frame_visibility.size())
     {
-        return m_frames[_index]->duration;
+        return (*m_frames)[_index].duration;
     }
     return std::nullopt;
 }
 
 bool GraphicsPack::setCurrentFrameIndex(size_t _index)
 {
-    if(_index >= m_frames.size() || !m_frames[_index]->is_visible)
+    if(_index >= m_frame_visibility.size() || !m_frame_visibility[_index])
         return false;
     m_current_frame_index = _index;
     m_current_frame_duration = std::chrono::milliseconds::zero();
     return true;
 }
 
+bool GraphicsPack::restorePlayback(
+    size_t _frame_index,
+    size_t _iteration,
+    std::chrono::milliseconds _frame_elapsed_time)
+{
+    if(!setCurrentFrameIndex(_frame_index))
+        return false;
+    m_current_iteration = static_cast<int32_t>(_iteration);
+    m_current_frame_duration = _frame_elapsed_time;
+    return true;
+}
+
 std::pair<bool, size_t> GraphicsPack::addSprite(size_t _frame, const GraphicsPackSpriteDefinition & _definition)
 {
-    if(_frame >= m_frames.size())
+    if(_frame >= m_frame_visibility.size())
         return std::make_pair(false, 0);
-    std::vector<Graphics> & graphics = m_frames[_frame]->graphics;
+    std::vector<Graphics> & graphics = getWritableFrames()[_frame].graphics;
     graphics.emplace_back(_definition);
     return std::make_pair(true, graphics.size() - 1);
 }
 
 bool GraphicsPack::removeSprite(size_t _frame, size_t _sprite)
 {
-    if(_frame >= m_frames.size())
-        return false;
-    std::vector<Graphics> & graphics = m_frames[_frame]->graphics;
-    if(_sprite >= graphics.size())
+    if(_frame >= m_frame_visibility.size() || _sprite >= (*m_frames)[_frame].graphics.size())
         return false;
+    std::vector<Graphics> & graphics = getWritableFrames()[_frame].graphics;
     graphics.erase(graphics.begin() + _sprite);
     return true;
 }
 
-void GraphicsPack::render(
-    const SDL_FPoint & _position,
-    const Rotation & _rotation,
-    std::chrono::milliseconds _delta_time)
+void GraphicsPack::advance(std::chrono::milliseconds _delta_time)
 {
-    if(m_max_iterations == 0 || m_total_duration == std::chrono::milliseconds::zero())
-    {
-        performRender(_position, _rotation);
+    if(!isAnimated())
         return;
-    }
     m_current_frame_duration += _delta_time;
-    const Frame * frame = m_frames[m_current_frame_index];
     bool respect_iterations = m_max_iterations > 0;
-    if(!frame->is_visible)
+    if(!m_frame_visibility[m_current_frame_index])
     {
         if(switchToNextVisibleFrame(respect_iterations))
         {
@@ -331,30 +258,36 @@ void GraphicsPack::render(
     }
     for(;;)
     {
-        if(frame->duration < m_current_frame_duration)
+        const std::chrono::milliseconds frame_duration = (*m_frames)[m_current_frame_index].duration;
+        if(frame_duration < m_current_frame_duration)
         {
-            m_current_frame_duration -= frame->duration;
+            m_current_frame_duration -= frame_duration;
             if(!switchToNextVisibleFrame(respect_iterations))
                 break;
-            frame = m_frames[m_current_frame_index];
         }
         else
         {
             break;
         }
     }
-    performRender(_position, _rotation);
+}
+
+std::chrono::milliseconds GraphicsPack::getFrameTimeLeft() const
+{
+    if(!isAnimated() || (m_max_iterations > 0 && m_current_iteration >= m_max_iterations))
+        return std::chrono::milliseconds::max();
+    return (*m_frames)[m_current_frame_index].duration - m_current_frame_duration;
 }
 
 bool GraphicsPack::switchToFirstVisibleFrame()
 {
-    if(m_frames.empty())
+    if(m_frame_visibility.empty())
         return false;
     if(m_current_frame_index == 0)
         return true;
     m_current_frame_index = 0;
     m_current_frame_duration = std::chrono::milliseconds::zero();
-    if(!m_frames[m_current_frame_index]->is_visible)
+    if(!m_frame_visibility[m_current_frame_index])
         return switchToNextVisibleFrame();
     return true;
 }
@@ -369,9 +302,9 @@ bool GraphicsPack::switchToNextVisibleFrame(bool _respect_iteration)
     if(_respect_iteration && m_current_iteration > m_max_iterations)
         return false;
 
-    for(size_t i = m_current_frame_index + 1; i < m_frames.size(); ++i)
+    for(size_t i = m_current_frame_index + 1; i < m_frame_visibility.size(); ++i)
     {
-        if(m_frames[i]->is_visible)
+        if(m_frame_visibility[i])
         {
             m_current_frame_index = i;
             return true;
@@ -387,7 +320,7 @@ bool GraphicsPack::switchToNextVisibleFrame(bool _respect_iteration)
 
         for(size_t i = 0; i < m_current_frame_index; ++i)
         {
-            if(m_frames[i]->is_visible)
+            if(m_frame_visibility[i])
             {
                 m_current_frame_index = i;
                 return true;
@@ -395,21 +328,16 @@ bool GraphicsPack::switchToNextVisibleFrame(bool _respect_iteration)
         }
     }
 
-    return m_frames[m_current_frame_index]->is_visible;
+    return m_frame_visibility[m_current_frame_index];
 }
 
-void GraphicsPack::performRender(const SDL_FPoint & _position, const Rotation & _rotation)
+void GraphicsPack::render(const SDL_FPoint & _position, const Rotation & _rotation) const
 {
-    if(m_frames.empty())
-    {
-        return;
-    }
-    Frame * frame = m_frames[m_current_frame_index];
-    if(!frame->is_visible)
+    if(m_frame_visibility.empty() || !m_frame_visibility[m_current_frame_index])
     {
         return;
     }
-    for(Graphics & graphics : frame->graphics)
+    for(const Graphics & graphics : (*m_frames)[m_current_frame_index].graphics)
     {
         if(graphics.sprite.has_value() && graphics.is_visible)
         {
@@ -32,16 +32,14 @@ class GraphicsPack final
 private:
     struct Graphics;
     struct Frame;
+    using Frames = std::vector<Frame>;
 
 public:
+    S2_DEFAULT_COPY_AND_MOVE(GraphicsPack)
+
     explicit GraphicsPack(
         Renderer & _renderer,
         const GraphicsPackDefinition & _definition = GraphicsPackDefinition());
-    GraphicsPack(const GraphicsPack & _graphics_pack);
-    GraphicsPack(GraphicsPack && _graphics_pack);
-    ~GraphicsPack();
-    GraphicsPack & operator = (const GraphicsPack & _graphics_pack);
-    GraphicsPack & operator = (GraphicsPack && _graphics_pack);
 
     void setFilippedHorizontally(bool _flipped);
     void setFilippedVertically(bool _flipped);
@@ -58,20 +56,26 @@ public:
     bool switchToFirstVisibleFrame();
     bool switchToNextVisibleFrame();
     size_t getCurrentAnimationIteration() const;
+    std::chrono::milliseconds getCurrentFrameElapsedTime() const;
+    bool restorePlayback(size_t _frame_index, size_t _iteration, std::chrono::milliseconds _frame_elapsed_time);
     std::pair<bool, size_t> addSprite(size_t _frame, const GraphicsPackSpriteDefinition & _definition);
     bool removeSprite(size_t _frame, size_t _sprite);
-    void render(const SDL_FPoint & _position, const Rotation & _rotation, std::chrono::milliseconds _delta_time);
+    void advance(std::chrono::milliseconds _delta_time);
+    std::chrono::milliseconds getFrameTimeLeft() const;
+    void render(const SDL_FPoint & _position, const Rotation & _rotation) const;
 
 private:
+    Frames & getWritableFrames();
+    bool isAnimated() const;
     bool switchToNextVisibleFrame(bool _respect_iteration);
-    void destroy();
-    void performRender(const SDL_FPoint & _position, const Rotation & _rotation);
 
 private:
     Renderer * mp_renderer;
     SDL_FPoint m_position;
     SDL_FlipMode m_flip_mode;
-    std::vector<Frame *> m_frames;
+    // Frames are shared between copies of the pack until one of them modifies them
+    std::shared_ptr<Frames> m_frames;
+    std::vector<bool> m_frame_visibility;
     int32_t m_max_iterations;
     int32_t m_current_iteration;
     size_t m_current_frame_index;
@@ -98,9 +102,19 @@ inline void GraphicsPack::setFilippedVertically(bool _flipped)
         : static_cast<SDL_FlipMode>(static_cast<int>(m_flip_mode) & ~SDL_FLIP_VERTICAL);
 }
 
+inline bool GraphicsPack::isAnimated() const
+{
+    return m_max_iterations != 0 && m_total_duration != std::chrono::milliseconds::zero();
+}
+
 inline size_t GraphicsPack::getCurrentAnimationIteration() const
 {
     return m_current_iteration;
 }
 
+inline std::chrono::milliseconds GraphicsPack::getCurrentFrameElapsedTime() const
+{
+    return m_current_frame_duration;
+}
+
 } // namespace Sol2D
@@ -45,6 +45,9 @@
 //
 // Callbacks are records: (<Subscription ID>, <Lua Function>)
 //
+// Owners can also keep their own tables next to the events.
+// These tables are destroyed along with the owner's callbacks.
+//
 
 using namespace Sol2D;
 using namespace Sol2D::Lua;
@@ -214,3 +217,15 @@ void LuaCallbackStorage::destroyCallbacks(const void * _owner)
     lua_pushnil(mp_lua);
     lua_setfield(mp_lua, -2, makeOwnerKey(_owner).c_str());
 }
+
+bool LuaCallbackStorage::pushOwnerTable(const void * _owner, const char * _key)
+{
+    if(s_is_disposed) return false;
+
+    getCallbackRegisty();
+    luaL_getsubtable(mp_lua, -1, makeOwnerKey(_owner).c_str());
+    luaL_getsubtable(mp_lua, -1, _key);
+    lua_remove(mp_lua, -2);
+    lua_remove(mp_lua, -2);
+    return true;
+}
@@ -45,6 +45,7 @@ public:
         uint16_t _return_count = 0,
         std::optional<std::function<bool()>> _callback = std::nullopt);
     void destroyCallbacks(const void * _owner);
+    bool pushOwnerTable(const void * _owner, const char * _key);
 
 private:
     static int luaGC(lua_State *);
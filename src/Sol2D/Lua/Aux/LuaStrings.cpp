@@ -52,6 +52,16 @@ const char LuaTypeName::graphics_pack[]                  = "sol.GraphicsPack";
 const char LuaTypeName::body_type[]                      = "sol.BodyType";
 const char LuaTypeName::body_shape_type[]                = "sol.BodyShapeType";
 const char LuaTypeName::body_prototype[]                 = "sol.BodyPrototype";
+const char LuaTypeName::body_prototype_overrides[]       = "sol.BodyPrototypeOverrides";
+const char LuaTypeName::contact_type[]                   = "sol.ContactType";
+const char LuaTypeName::contact_filter[]                 = "sol.ContactFilter";
+const char LuaTypeName::rect[]                           = "sol.Rectangle";
+const char LuaTypeName::ray_cast[]                       = "sol.RayCast";
+const char LuaTypeName::shape_cast[]                     = "sol.ShapeCast";
+const char LuaTypeName::query_options[]                  = "sol.QueryOptions";
+const char LuaTypeName::path_options[]                   = "sol.PathOptions";
+const char LuaTypeName::flow_field_options[]             = "sol.FlowFieldOptions";
+const char LuaTypeName::activity_region_options[]        = "sol.ActivityRegionOptions";
 const char LuaTypeName::distance_joint_definition[]      = "sol.DistanceJointDefinition";
 const char LuaTypeName::motor_joint_definition[]         = "sol.MotorJointDefinition";
 const char LuaTypeName::mouse_joint_definition[]         = "sol.MouseJointDefinition";
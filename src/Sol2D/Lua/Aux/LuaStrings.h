@@ -57,6 +57,16 @@ struct LuaTypeName
     static const char body_type[];
     static const char body_shape_type[];
     static const char body_prototype[];
+    static const char body_prototype_overrides[];
+    static const char contact_type[];
+    static const char contact_filter[];
+    static const char rect[];
+    static const char ray_cast[];
+    static const char shape_cast[];
+    static const char query_options[];
+    static const char path_options[];
+    static const char flow_field_options[];
+    static const char activity_region_options[];
     static const char distance_joint_definition[];
     static const char motor_joint_definition[];
     static const char mouse_joint_definition[];
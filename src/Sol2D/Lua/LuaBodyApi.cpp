@@ -136,7 +136,7 @@ int luaApi_SetPosition(lua_State * _lua)
     Self * self = UserData::getUserData(_lua, 1);
     SDL_FPoint position;
     luaL_argexpected(_lua, tryGetPoint(_lua, 2, position), 2, LuaTypeName::point);
-    self->getData(_lua).body->setPosition(position);
+    self->getData(_lua).scene->setBodyPosition(self->body_id, position);
     return 0;
 }
 
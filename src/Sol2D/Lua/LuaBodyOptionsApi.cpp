@@ -48,5 +48,8 @@ bool Sol2D::Lua::tryGetBodyOptions(lua_State * _lua, int _idx, BodyOptions & _bo
         lua_pop(_lua, 1);
     }
     table.tryGetString("shapeKey", _body_options.shape_key);
+    table.tryGetBoolean("merge", &_body_options.is_merged);
+    table.tryGetBoolean("chainOutlines", &_body_options.use_chain_outlines);
+    table.tryGetBoolean("mergeRectangles", &_body_options.merge_rectangles);
     return true;
 }
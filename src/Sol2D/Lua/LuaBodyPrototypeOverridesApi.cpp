@@ -0,0 +1,37 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <Sol2D/Lua/LuaBodyPrototypeOverridesApi.h>
+#include <Sol2D/Lua/Aux/LuaTable.h>
+
+using namespace Sol2D::World;
+
+bool Sol2D::Lua::tryGetBodyPrototypeOverrides(lua_State * _lua, int _idx, BodyPrototypeOverrides & _overrides)
+{
+    LuaTable table(_lua, _idx);
+    if(!table.isValid())
+    {
+        return false;
+    }
+    {
+        lua_Integer lua_int;
+        if(table.tryGetInteger("type", &lua_int))
+            _overrides.type = castToBodyType(lua_int);
+    }
+    table.tryGetString("layer", _overrides.layer);
+    table.tryGetPoint("linearVelocity", _overrides.linear_velocity);
+    return true;
+}
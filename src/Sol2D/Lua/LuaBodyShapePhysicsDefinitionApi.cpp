@@ -18,6 +18,48 @@
 #include <Sol2D/Lua/Aux/LuaTable.h>
 
 using namespace Sol2D::World;
+using namespace Sol2D::Lua;
+
+namespace {
+
+bool tryGetStrings(lua_State * _lua, int _idx, std::vector<std::string> & _strings)
+{
+    if(!lua_istable(_lua, _idx))
+        return false;
+    const int table_idx = lua_absindex(_lua, _idx);
+    const size_t count = lua_rawlen(_lua, table_idx);
+    _strings.reserve(count);
+    for(size_t i = 1; i <= count; ++i)
+    {
+        if(lua_rawgeti(_lua, table_idx, static_cast<lua_Integer>(i)) == LUA_TSTRING)
+            _strings.emplace_back(lua_tostring(_lua, -1));
+        lua_pop(_lua, 1);
+    }
+    return true;
+}
+
+} // namespace
+
+bool Sol2D::Lua::tryGetCollisionFilter(lua_State * _lua, int _idx, CollisionFilterDefinition & _filter)
+{
+    LuaTable table(_lua, _idx);
+    if(!table.isValid())
+        return false;
+    if(table.tryGetValue("categories"))
+    {
+        tryGetStrings(_lua, -1, _filter.categories);
+        lua_pop(_lua, 1);
+    }
+    if(table.tryGetValue("mask"))
+    {
+        std::vector<std::string> mask;
+        if(tryGetStrings(_lua, -1, mask))
+            _filter.mask = std::move(mask);
+        lua_pop(_lua, 1);
+    }
+    table.tryGetInteger("group", _filter.group);
+    return true;
+}
 
 bool Sol2D::Lua::tryGetBodyShapePhysicsDefinition(lua_State * _lua, int _idx, BodyShapePhysicsDefinition & _definition)
 {
@@ -27,6 +69,12 @@ bool Sol2D::Lua::tryGetBodyShapePhysicsDefinition(lua_State * _lua, int _idx, Bo
         table.tryGetNumber("density", _definition.density);
         table.tryGetNumber("restitution", _definition.restitution);
         table.tryGetNumber("friction",  _definition.friction);
+        table.tryGetString("tag", _definition.tag);
+        if(table.tryGetValue("collisionFilter"))
+        {
+            tryGetCollisionFilter(_lua, -1, _definition.collision_filter);
+            lua_pop(_lua, 1);
+        }
         table.tryGetBoolean("isSensor", &_definition.is_sensor);
         table.tryGetBoolean("isPreSolveEnabled", &_definition.is_pre_solve_enabled);
         return true;
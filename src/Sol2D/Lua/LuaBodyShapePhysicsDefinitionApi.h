@@ -21,6 +21,7 @@
 
 namespace Sol2D::Lua {
 
+bool tryGetCollisionFilter(lua_State * _lua, int _idx, World::CollisionFilterDefinition & _filter);
 bool tryGetBodyShapePhysicsDefinition(lua_State * _lua, int _idx, World::BodyShapePhysicsDefinition & _definition);
 
 } // namespace Sol2D::Lua
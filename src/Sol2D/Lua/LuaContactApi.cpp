@@ -37,6 +37,8 @@ void pushContactSide(lua_State * _lua, const ContactSide & _side)
     side_a_table.setStringValue(key_shape, _side.shape_key);
     if(_side.tile_map_object_id.has_value())
         side_a_table.setIntegerValue(key_tile_map_object_id, _side.tile_map_object_id.value());
+    if(_side.tag.has_value())
+        side_a_table.setStringValue("tag", _side.tag.value());
 }
 
 void setContactSide(LuaTable & _table, const char * _key, const ContactSide & _side)
@@ -45,6 +47,32 @@ void setContactSide(LuaTable & _table, const char * _key, const ContactSide & _s
     _table.setValueFromTop(_key);
 }
 
+struct ContactRecordSideKeys
+{
+    const char * body;
+    const char * shape;
+    const char * tile_map_object_id;
+    const char * tag;
+};
+
+const ContactRecordSideKeys gc_record_side_a_keys = { "bodyIdA", "shapeKeyA", "tileMapObjectIdA", "tagA" };
+const ContactRecordSideKeys gc_record_side_b_keys = { "bodyIdB", "shapeKeyB", "tileMapObjectIdB", "tagB" };
+
+// Optional fields are reset explicitly, because the record may keep values from the previous step
+void setContactRecordSide(LuaTable & _table, const ContactRecordSideKeys & _keys, const ContactSide & _side)
+{
+    _table.setIntegerValue(_keys.body, static_cast<lua_Integer>(_side.body_id));
+    _table.setStringValue(_keys.shape, _side.shape_key);
+    if(_side.tile_map_object_id.has_value())
+        _table.setIntegerValue(_keys.tile_map_object_id, _side.tile_map_object_id.value());
+    else
+        _table.setNullValue(_keys.tile_map_object_id);
+    if(_side.tag.has_value())
+        _table.setStringValue(_keys.tag, _side.tag.value());
+    else
+        _table.setNullValue(_keys.tag);
+}
+
 } // namespace name
 
 void Sol2D::Lua::pushContact(lua_State * _lua, const Contact & _contact)
@@ -69,3 +97,51 @@ void Sol2D::Lua::pushContact(lua_State * _lua, const PreSolveContact & _contact)
     pushManifold(_lua, *_contact.manifold);
     contact_table.setValueFromTop("manifold");
 }
+
+bool Sol2D::Lua::tryGetContactFilter(lua_State * _lua, int _idx, ContactFilter & _filter)
+{
+    LuaTable table(_lua, _idx);
+    if(!table.isValid())
+        return false;
+    table.tryGetInteger("bodyId", _filter.body_id);
+    table.tryGetString("shapeKey", _filter.shape_key);
+    table.tryGetString("tag", _filter.tag);
+    return true;
+}
+
+size_t Sol2D::Lua::fillContactRecords(
+    lua_State * _lua,
+    int _array_idx,
+    int _pool_idx,
+    std::span<const ContactRecord> _contacts,
+    const ContactFilter & _filter)
+{
+    const int array_idx = lua_absindex(_lua, _array_idx);
+    const int pool_idx = lua_absindex(_lua, _pool_idx);
+    const lua_Integer previous_count = static_cast<lua_Integer>(lua_rawlen(_lua, array_idx));
+    lua_Integer count = 0;
+    for(const ContactRecord & contact : _contacts)
+    {
+        if(!_filter.matches(contact))
+            continue;
+        ++count;
+        if(lua_rawgeti(_lua, pool_idx, count) != LUA_TTABLE)
+        {
+            lua_pop(_lua, 1);
+            lua_createtable(_lua, 0, 9);
+            lua_pushvalue(_lua, -1);
+            lua_rawseti(_lua, pool_idx, count);
+        }
+        LuaTable record_table(_lua);
+        record_table.setIntegerValue("type", static_cast<lua_Integer>(contact.type));
+        setContactRecordSide(record_table, gc_record_side_a_keys, contact.side_a);
+        setContactRecordSide(record_table, gc_record_side_b_keys, contact.side_b);
+        lua_rawseti(_lua, array_idx, count);
+    }
+    for(lua_Integer i = previous_count; i > count; --i)
+    {
+        lua_pushnil(_lua);
+        lua_rawseti(_lua, array_idx, i);
+    }
+    return static_cast<size_t>(count);
+}
@@ -24,5 +24,12 @@ namespace Sol2D::Lua {
 void pushContact(lua_State * _lua, const World::Contact & _contact);
 void pushContact(lua_State * _lua, const World::SensorContact & _contact);
 void pushContact(lua_State * _lua, const World::PreSolveContact & _contact);
+bool tryGetContactFilter(lua_State * _lua, int _idx, World::ContactFilter & _filter);
+size_t fillContactRecords(
+    lua_State * _lua,
+    int _array_idx,
+    int _pool_idx,
+    std::span<const World::ContactRecord> _contacts,
+    const World::ContactFilter & _filter);
 
 } // namespace Sol2D::Lua
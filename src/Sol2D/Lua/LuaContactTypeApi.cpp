@@ -0,0 +1,38 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <Sol2D/Lua/Aux/LuaMetatable.h>
+#include <Sol2D/Lua/Aux/LuaTable.h>
+#include <Sol2D/Lua/LuaContactTypeApi.h>
+#include <Sol2D/Lua/Aux/LuaStrings.h>
+#include <Sol2D/World/Contact.h>
+
+using namespace Sol2D::World;
+using namespace Sol2D::Lua;
+
+void Sol2D::Lua::pushContactTypeEnum(lua_State * _lua)
+{
+    lua_newuserdata(_lua, 1);
+    if(pushMetatable(_lua, LuaTypeName::contact_type) == MetatablePushResult::Created)
+    {
+        LuaTable table(_lua);
+        table.setIntegerValue("BEGIN", static_cast<lua_Integer>(ContactType::Begin));
+        table.setIntegerValue("END", static_cast<lua_Integer>(ContactType::End));
+        table.setIntegerValue("SENSOR_BEGIN", static_cast<lua_Integer>(ContactType::SensorBegin));
+        table.setIntegerValue("SENSOR_END", static_cast<lua_Integer>(ContactType::SensorEnd));
+    }
+    lua_setmetatable(_lua, -2);
+}
@@ -14,9 +14,12 @@
 // You should have received a copy of the GNU Lesser General Public License
 // along with this program. If not, see <http://www.gnu.org/licenses/>.
 
-#include <Sol2D/World/Body.h>
+#pragma once
 
-using namespace Sol2D::World;
-using namespace Sol2D::Utils;
+#include <Sol2D/Lua/Aux/LuaForward.h>
 
-SequentialId<uint64_t> Body::s_sequential_id;
+namespace Sol2D::Lua {
+
+void pushContactTypeEnum(lua_State * _lua);
+
+} // namespace Sol2D::Lua
@@ -20,6 +20,7 @@
 #include <Sol2D/Lua/LuaScancodeApi.h>
 #include <Sol2D/Lua/LuaBodyTypeApi.h>
 #include <Sol2D/Lua/LuaBodyShapeTypeApi.h>
+#include <Sol2D/Lua/LuaContactTypeApi.h>
 #include <Sol2D/Lua/LuaKeyboardApi.h>
 #include <Sol2D/Lua/LuaMouseApi.h>
 #include <Sol2D/Lua/LuaTileMapObjectApi.h>
@@ -86,7 +87,7 @@ LuaLibrary::LuaLibrary(
     lua_newuserdata(mp_lua, 1);
     if(pushMetatable(mp_lua, LuaTypeName::lib) == MetatablePushResult::Created)
     {
-        pushWindowApi(mp_lua, _window);
+        pushWindowApi(mp_lua, _window, _renderer);
         lua_setfield(mp_lua, -2, "window");
         pushKeyboardApi(mp_lua);
         lua_setfield(mp_lua, -2, "keyboard");
@@ -100,6 +101,8 @@ LuaLibrary::LuaLibrary(
         lua_setfield(mp_lua, -2, "BodyType");
         pushBodyShapeTypeEnum(mp_lua);
         lua_setfield(mp_lua, -2, "BodyShapeType");
+        pushContactTypeEnum(mp_lua);
+        lua_setfield(mp_lua, -2, "ContactType");
         pushTileMapObjectTypeEnum(mp_lua);
         lua_setfield(mp_lua, -2, "TileMapObjectType");
         pushDimensionUnitEnum(mp_lua);
@@ -0,0 +1,65 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <Sol2D/Lua/LuaPathFindingApi.h>
+#include <Sol2D/Lua/LuaPointApi.h>
+#include <Sol2D/Lua/Aux/LuaTable.h>
+
+using namespace Sol2D::World;
+using namespace Sol2D::Lua;
+
+bool Sol2D::Lua::tryGetPathOptions(lua_State * _lua, int _idx, AStarOptions & _options)
+{
+    LuaTable table(_lua, _idx);
+    if(!table.isValid())
+        return false;
+    table.tryGetBoolean("allowDiagonalSteps", &_options.allow_diagonal_steps);
+    table.tryGetBoolean("avoidSensors", &_options.avoid_sensors);
+    table.tryGetBoolean("allowPartialPath", &_options.allow_partial_path);
+    table.tryGetBoolean("hierarchical", &_options.is_hierarchical);
+    table.tryGetUnsignedInteger("maxExpansions", &_options.max_expansions);
+    return _options.max_expansions > 0;
+}
+
+bool Sol2D::Lua::tryGetFlowFieldOptions(lua_State * _lua, int _idx, FlowFieldOptions & _options)
+{
+    LuaTable table(_lua, _idx);
+    if(!table.isValid())
+        return false;
+    table.tryGetRect("area", _options.area);
+    table.tryGetSize("cellSize", _options.cell_size);
+    table.tryGetBoolean("allowDiagonalSteps", &_options.allow_diagonal_steps);
+    table.tryGetBoolean("avoidSensors", &_options.avoid_sensors);
+    return true;
+}
+
+// Pushes two values: the points or false if the path is not found, and whether the path is complete
+void Sol2D::Lua::pushPath(lua_State * _lua, const std::optional<std::vector<SDL_FPoint>> & _points, bool _is_complete)
+{
+    if(!_points.has_value())
+    {
+        lua_pushboolean(_lua, false);
+        lua_pushboolean(_lua, false);
+        return;
+    }
+    lua_createtable(_lua, static_cast<int>(_points.value().size()), 0);
+    for(size_t i = 0; i < _points.value().size(); ++i)
+    {
+        pushPoint(_lua, _points.value()[i]);
+        lua_rawseti(_lua, -2, i + 1);
+    }
+    lua_pushboolean(_lua, _is_complete);
+}
@@ -20,11 +20,16 @@
 #include <Sol2D/Lua/LuaBodyDefinitionApi.h>
 #include <Sol2D/Lua/LuaJointDefinitionApi.h>
 #include <Sol2D/Lua/LuaBodyOptionsApi.h>
+#include <Sol2D/Lua/LuaBodyPrototypeOverridesApi.h>
 #include <Sol2D/Lua/LuaBodyApi.h>
 #include <Sol2D/Lua/LuaJointApi.h>
 #include <Sol2D/Lua/LuaContactApi.h>
 #include <Sol2D/Lua/LuaTileMapObjectApi.h>
 #include <Sol2D/Lua/LuaColorApi.h>
+#include <Sol2D/Lua/LuaRectApi.h>
+#include <Sol2D/Lua/LuaSpatialQueryApi.h>
+#include <Sol2D/Lua/LuaPathFindingApi.h>
+#include <Sol2D/Lua/LuaActivityRegionOptionsApi.h>
 #include <Sol2D/Lua/Aux/LuaStrings.h>
 #include <Sol2D/Lua/Aux/LuaUserData.h>
 #include <Sol2D/Lua/Aux/LuaCallbackStorage.h>
@@ -32,6 +37,7 @@
 #include <Sol2D/Lua/Aux/LuaScript.h>
 #include <Sol2D/Lua/Aux/LuaUtils.h>
 #include <sstream>
+#include <unordered_map>
 
 using namespace Sol2D;
 using namespace Sol2D::World;
@@ -46,8 +52,20 @@ const uint16_t gc_event_begin_sensor_contact = 2;
 const uint16_t gc_event_end_sensor_contact = 3;
 const uint16_t gc_event_pre_solve_contact = 4;
 
+const uint16_t gc_event_contacts = 0;
+
+const char gc_key_contact_records[] = "records";
+const char gc_key_contact_record_pool[] = "pool";
+
 const uint16_t gc_event_step = 0;
 
+const uint16_t gc_event_animation_frame_changed = 0;
+const uint16_t gc_event_animation_loop_ended = 1;
+
+const char gc_key_path_callbacks[] = "callbacks";
+
+const uint16_t gc_event_body_activity = 0;
+
 class LuaContactObserver : public ContactObserver, public ObjectCompanion
 {
 public:
@@ -103,6 +121,48 @@ private:
     const Workspace & mr_workspace;
 };
 
+class LuaContactBatchObserver : public ContactBatchObserver, public ObjectCompanion
+{
+public:
+    LuaContactBatchObserver(lua_State * _lua, const Workspace & _workspace) :
+        mp_lua(_lua),
+        mr_workspace(_workspace)
+    {
+    }
+
+    void setFilter(const ContactFilter & _filter)
+    {
+        m_filter = _filter;
+    }
+
+    ~LuaContactBatchObserver() override
+    {
+        LuaCallbackStorage(mp_lua).destroyCallbacks(this);
+    }
+
+    void onContacts(std::span<const ContactRecord> _contacts) override
+    {
+        LuaCallbackStorage storage(mp_lua);
+        if(!storage.pushOwnerTable(this, gc_key_contact_records))
+            return;
+        storage.pushOwnerTable(this, gc_key_contact_record_pool);
+        const size_t count = fillContactRecords(mp_lua, -2, -1, _contacts, m_filter);
+        lua_pop(mp_lua, 1);
+        if(count == 0)
+        {
+            lua_pop(mp_lua, 1);
+            return;
+        }
+        lua_pushinteger(mp_lua, static_cast<lua_Integer>(count));
+        storage.execute(mr_workspace, this, gc_event_contacts, 2);
+    }
+
+private:
+    lua_State * mp_lua;
+    const Workspace & mr_workspace;
+    ContactFilter m_filter;
+};
+
 class LuaStepObserver : public StepObserver, public ObjectCompanion
 {
 public:
@@ -128,6 +188,130 @@ private:
     const Workspace & mr_workspace;
 };
 
+class LuaAnimationObserver : public AnimationObserver, public ObjectCompanion
+{
+public:
+    LuaAnimationObserver(lua_State * _lua, const Workspace & _workspace) :
+        mp_lua(_lua),
+        mr_workspace(_workspace)
+    {
+    }
+
+    ~LuaAnimationObserver() override
+    {
+        LuaCallbackStorage(mp_lua).destroyCallbacks(this);
+    }
+
+    void onAnimationFrameChanged(const AnimationEvent & _event) override
+    {
+        execute(_event, gc_event_animation_frame_changed);
+    }
+
+    void onAnimationLoopEnded(const AnimationEvent & _event) override
+    {
+        execute(_event, gc_event_animation_loop_ended);
+    }
+
+private:
+    void execute(const AnimationEvent & _event, uint16_t _event_id)
+    {
+        lua_pushinteger(mp_lua, static_cast<lua_Integer>(_event.body_id));
+        lua_pushstring(mp_lua, _event.shape_key.c_str());
+        lua_pushinteger(mp_lua, static_cast<lua_Integer>(_event.frame_index));
+        LuaCallbackStorage(mp_lua).execute(mr_workspace, this, _event_id, 3);
+    }
+
+private:
+    lua_State * mp_lua;
+    const Workspace & mr_workspace;
+};
+
+class LuaBodyActivityObserver : public BodyActivityObserver, public ObjectCompanion
+{
+public:
+    LuaBodyActivityObserver(lua_State * _lua, const Workspace & _workspace) :
+        mp_lua(_lua),
+        mr_workspace(_workspace)
+    {
+    }
+
+    ~LuaBodyActivityObserver() override
+    {
+        LuaCallbackStorage(mp_lua).destroyCallbacks(this);
+    }
+
+    void onBodyActivityChanged(uint64_t _body_id, bool _is_active) override
+    {
+        lua_pushinteger(mp_lua, static_cast<lua_Integer>(_body_id));
+        lua_pushboolean(mp_lua, _is_active);
+        LuaCallbackStorage(mp_lua).execute(mr_workspace, this, gc_event_body_activity, 2);
+    }
+
+private:
+    lua_State * mp_lua;
+    const Workspace & mr_workspace;
+};
+
+class LuaPathObserver : public PathObserver, public ObjectCompanion
+{
+public:
+    LuaPathObserver(lua_State * _lua, const Workspace & _workspace) :
+        mp_lua(_lua),
+        mr_workspace(_workspace)
+    {
+    }
+
+    ~LuaPathObserver() override
+    {
+        LuaCallbackStorage(mp_lua).destroyCallbacks(this);
+    }
+
+    void setCallback(uint64_t _request_id, int _callback_idx)
+    {
+        _callback_idx = lua_absindex(mp_lua, _callback_idx);
+        if(!LuaCallbackStorage(mp_lua).pushOwnerTable(this, gc_key_path_callbacks))
+            return;
+        lua_pushvalue(mp_lua, _callback_idx);
+        lua_rawseti(mp_lua, -2, static_cast<lua_Integer>(_request_id));
+        lua_pop(mp_lua, 1);
+    }
+
+    void removeCallback(uint64_t _request_id)
+    {
+        if(!LuaCallbackStorage(mp_lua).pushOwnerTable(this, gc_key_path_callbacks))
+            return;
+        lua_pushnil(mp_lua);
+        lua_rawseti(mp_lua, -2, static_cast<lua_Integer>(_request_id));
+        lua_pop(mp_lua, 1);
+    }
+
+    void onPathFound(uint64_t _request_id, const PathResult & _result) override
+    {
+        if(!LuaCallbackStorage(mp_lua).pushOwnerTable(this, gc_key_path_callbacks))
+            return;
+        if(lua_rawgeti(mp_lua, -1, static_cast<lua_Integer>(_request_id)) != LUA_TFUNCTION)
+        {
+            lua_pop(mp_lua, 2);
+            return;
+        }
+        // Each callback is called once
+        lua_pushnil(mp_lua);
+        lua_rawseti(mp_lua, -3, static_cast<lua_Integer>(_request_id));
+        lua_remove(mp_lua, -2);
+        lua_pushinteger(mp_lua, static_cast<lua_Integer>(_request_id));
+        pushPath(mp_lua, _result.points, _result.is_complete);
+        if(lua_pcall(mp_lua, 3, 0, 0) != LUA_OK)
+        {
+            mr_workspace.getMainLogger().error(lua_tostring(mp_lua, -1));
+            lua_pop(mp_lua, 1);
+        }
+    }
+
+private:
+    lua_State * mp_lua;
+    const Workspace & mr_workspace;
+};
+
 struct Self : LuaSelfBase
 {
 public:
@@ -135,7 +319,10 @@ public:
         workspace(_workspace),
         m_scene(_scene),
         m_contact_observer_companion_id(null_companion_id),
-        m_step_observer_companion_id(null_companion_id)
+        m_step_observer_companion_id(null_companion_id),
+        m_animation_observer_companion_id(null_companion_id),
+        m_path_observer_companion_id(null_companion_id),
+        m_body_activity_observer_companion_id(null_companion_id)
     {
     }
 
@@ -145,6 +332,21 @@ public:
         {
             scene->removeCompanion(m_contact_observer_companion_id);
             scene->removeCompanion(m_step_observer_companion_id);
+            scene->removeCompanion(m_animation_observer_companion_id);
+            for(const auto & pair : m_contact_batch_subscriptions)
+                removeContactBatchObserver(*scene, pair.second);
+            for(uint64_t companion_id : m_idle_contact_batch_observer_companion_ids)
+                removeContactBatchObserver(*scene, companion_id);
+            if(ObjectCompanion * path_observer = scene->getCompanion(m_path_observer_companion_id))
+            {
+                scene->removeObserver(*static_cast<LuaPathObserver *>(path_observer));
+                scene->removeCompanion(m_path_observer_companion_id);
+            }
+            if(ObjectCompanion * activity_observer = scene->getCompanion(m_body_activity_observer_companion_id))
+            {
+                scene->removeObserver(*static_cast<LuaBodyActivityObserver *>(activity_observer));
+                scene->removeCompanion(m_body_activity_observer_companion_id);
+            }
         }
     }
 
@@ -158,10 +360,25 @@ public:
 
     uint32_t subscribeOnContact(lua_State * _lua, uint16_t _event_id, int _callback_idx);
     void unsubscribeOnContact(lua_State * _lua, uint16_t _event_id, int _subscription_id);
+    uint32_t subscribeOnContacts(lua_State * _lua, const ContactFilter & _filter, int _callback_idx);
+    void unsubscribeOnContacts(lua_State * _lua, uint32_t _subscription_id);
     uint32_t subscribeOnStep(lua_State * _lua, int _callback_idx);
     void unsubscribeOnStep(lua_State * _lua, int _subscription_id);
+    uint32_t subscribeOnAnimation(lua_State * _lua, uint16_t _event_id, int _callback_idx);
+    void unsubscribeOnAnimation(lua_State * _lua, uint16_t _event_id, int _subscription_id);
+    uint32_t subscribeOnBodyActivity(lua_State * _lua, int _callback_idx);
+    void unsubscribeOnBodyActivity(lua_State * _lua, int _subscription_id);
+    std::optional<uint64_t> requestPath(
+        lua_State * _lua,
+        uint64_t _body_id,
+        const SDL_FPoint & _destination,
+        const AStarOptions & _options,
+        std::optional<int> _callback_idx);
+    bool cancelPathRequest(lua_State * _lua, uint64_t _request_id);
 
 private:
+    static void removeContactBatchObserver(Scene & _scene, uint64_t _companion_id);
+
     template<typename ObserverType>
     uint32_t subscribe(lua_State * _lua, uint16_t _event_id, uint64_t * _companion_id, int _callback_idx);
 
@@ -175,6 +392,11 @@ private:
     std::weak_ptr<Scene> m_scene;
     uint64_t m_contact_observer_companion_id;
     uint64_t m_step_observer_companion_id;
+    uint64_t m_animation_observer_companion_id;
+    uint64_t m_path_observer_companion_id;
+    uint64_t m_body_activity_observer_companion_id;
+    std::unordered_map<uint32_t, uint64_t> m_contact_batch_subscriptions; // Subscription ID -> companion ID
+    std::vector<uint64_t> m_idle_contact_batch_observer_companion_ids;
 };
 
 inline uint32_t Self::subscribeOnContact(lua_State * _lua, uint16_t _event_id, int _callback_idx)
@@ -187,6 +409,57 @@ inline void Self::unsubscribeOnContact(lua_State * _lua, uint16_t _event_id, int
     unsubscribe<LuaContactObserver>(_lua, _event_id, m_contact_observer_companion_id, _subscription_id);
 }
 
+uint32_t Self::subscribeOnContacts(lua_State * _lua, const ContactFilter & _filter, int _callback_idx)
+{
+    std::shared_ptr<Scene> scene = getScene(_lua);
+    LuaContactBatchObserver * observer = nullptr;
+    uint64_t companion_id;
+    if(m_idle_contact_batch_observer_companion_ids.empty())
+    {
+        observer = new LuaContactBatchObserver(_lua, workspace);
+        companion_id = scene->addCompanion(std::unique_ptr<ObjectCompanion>(observer));
+    }
+    else
+    {
+        companion_id = m_idle_contact_batch_observer_companion_ids.back();
+        m_idle_contact_batch_observer_companion_ids.pop_back();
+        observer = static_cast<LuaContactBatchObserver *>(scene->getCompanion(companion_id));
+    }
+    observer->setFilter(_filter);
+    uint32_t id = LuaCallbackStorage(_lua).addCallback(observer, gc_event_contacts, _callback_idx);
+    scene->addObserver(*observer);
+    m_contact_batch_subscriptions.insert(std::make_pair(id, companion_id));
+    return id;
+}
+
+void Self::unsubscribeOnContacts(lua_State * _lua, uint32_t _subscription_id)
+{
+    auto it = m_contact_batch_subscriptions.find(_subscription_id);
+    if(it == m_contact_batch_subscriptions.end())
+        return;
+    const uint64_t companion_id = it->second;
+    m_contact_batch_subscriptions.erase(it);
+    std::shared_ptr<Scene> scene = getScene(_lua);
+    ObjectCompanion * companion = scene->getCompanion(companion_id);
+    if(companion == nullptr)
+        return;
+    // The scene can be dispatching contacts to the observer right now, so the observer is not destroyed,
+    // but kept for the next subscription
+    LuaContactBatchObserver * observer = static_cast<LuaContactBatchObserver *>(companion);
+    scene->removeObserver(*observer);
+    LuaCallbackStorage(_lua).removeCallback(observer, gc_event_contacts, _subscription_id);
+    m_idle_contact_batch_observer_companion_ids.push_back(companion_id);
+}
+
+void Self::removeContactBatchObserver(Scene & _scene, uint64_t _companion_id)
+{
+    ObjectCompanion * companion = _scene.getCompanion(_companion_id);
+    if(companion == nullptr)
+        return;
+    _scene.removeObserver(*static_cast<LuaContactBatchObserver *>(companion));
+    _scene.removeCompanion(_companion_id);
+}
+
 uint32_t Self::subscribeOnStep(lua_State * _lua, int _callback_idx)
 {
     return subscribe<LuaStepObserver>(_lua, gc_event_step, &m_step_observer_companion_id, _callback_idx);
@@ -197,6 +470,68 @@ inline void Self::unsubscribeOnStep(lua_State * _lua, int _subscription_id)
     unsubscribe<LuaStepObserver>(_lua, gc_event_step, m_step_observer_companion_id, _subscription_id);
 }
 
+inline uint32_t Self::subscribeOnAnimation(lua_State * _lua, uint16_t _event_id, int _callback_idx)
+{
+    return subscribe<LuaAnimationObserver>(_lua, _event_id, &m_animation_observer_companion_id, _callback_idx);
+}
+
+inline void Self::unsubscribeOnAnimation(lua_State * _lua, uint16_t _event_id, int _subscription_id)
+{
+    unsubscribe<LuaAnimationObserver>(_lua, _event_id, m_animation_observer_companion_id, _subscription_id);
+}
+
+inline uint32_t Self::subscribeOnBodyActivity(lua_State * _lua, int _callback_idx)
+{
+    return subscribe<LuaBodyActivityObserver>(
+        _lua,
+        gc_event_body_activity,
+        &m_body_activity_observer_companion_id,
+        _callback_idx);
+}
+
+inline void Self::unsubscribeOnBodyActivity(lua_State * _lua, int _subscription_id)
+{
+    unsubscribe<LuaBodyActivityObserver>(
+        _lua,
+        gc_event_body_activity,
+        m_body_activity_observer_companion_id,
+        _subscription_id);
+}
+
+std::optional<uint64_t> Self::requestPath(
+    lua_State * _lua,
+    uint64_t _body_id,
+    const SDL_FPoint & _destination,
+    const AStarOptions & _options,
+    std::optional<int> _callback_idx)
+{
+    std::shared_ptr<Scene> scene = getScene(_lua);
+    std::optional<uint64_t> request_id = scene->requestPath(
+        _body_id,
+        _destination,
+        _options,
+        !_callback_idx.has_value());
+    if(!request_id.has_value() || !_callback_idx.has_value())
+        return request_id;
+    LuaPathObserver * observer = static_cast<LuaPathObserver *>(scene->getCompanion(m_path_observer_companion_id));
+    if(observer == nullptr)
+    {
+        observer = new LuaPathObserver(_lua, workspace);
+        m_path_observer_companion_id = scene->addCompanion(std::unique_ptr<ObjectCompanion>(observer));
+        scene->addObserver(*observer);
+    }
+    observer->setCallback(request_id.value(), _callback_idx.value());
+    return request_id;
+}
+
+bool Self::cancelPathRequest(lua_State * _lua, uint64_t _request_id)
+{
+    std::shared_ptr<Scene> scene = getScene(_lua);
+    if(ObjectCompanion * observer = scene->getCompanion(m_path_observer_companion_id))
+        static_cast<LuaPathObserver *>(observer)->removeCallback(_request_id);
+    return scene->cancelPathRequest(_request_id);
+}
+
 template<typename ObserverType>
 uint32_t Self::subscribe(lua_State * _lua, uint16_t _event_id, uint64_t * _companion_id, int _callback_idx)
 {
@@ -249,6 +584,63 @@ int luaApi_SetGravity(lua_State * _lua)
     return 1;
 }
 
+// 1 self
+// 2 category name
+int luaApi_DeclareCollisionCategory(lua_State * _lua)
+{
+    const Self * self = UserData::getUserData(_lua, 1);
+    const char * name = argToStringOrError(_lua, 2);
+    lua_pushboolean(_lua, self->getScene(_lua)->declareCollisionCategory(name));
+    return 1;
+}
+
+// 1 self
+// 2 tag
+// 3 normal
+int luaApi_SetOneWayNormal(lua_State * _lua)
+{
+    const Self * self = UserData::getUserData(_lua, 1);
+    const char * tag = argToStringOrError(_lua, 2);
+    SDL_FPoint normal;
+    luaL_argexpected(_lua, tryGetPoint(_lua, 3, normal), 3, LuaTypeName::point);
+    self->getScene(_lua)->setOneWayNormal(tag, normal);
+    return 0;
+}
+
+// 1 self
+// 2 tag
+int luaApi_RemoveOneWayNormal(lua_State * _lua)
+{
+    const Self * self = UserData::getUserData(_lua, 1);
+    const char * tag = argToStringOrError(_lua, 2);
+    lua_pushboolean(_lua, self->getScene(_lua)->removeOneWayNormal(tag));
+    return 1;
+}
+
+// 1 self
+// 2 tag A
+// 3 tag B
+int luaApi_IgnoreTagContacts(lua_State * _lua)
+{
+    const Self * self = UserData::getUserData(_lua, 1);
+    const char * tag_a = argToStringOrError(_lua, 2);
+    const char * tag_b = argToStringOrError(_lua, 3);
+    self->getScene(_lua)->ignoreTagContacts(tag_a, tag_b);
+    return 0;
+}
+
+// 1 self
+// 2 tag A
+// 3 tag B
+int luaApi_RestoreTagContacts(lua_State * _lua)
+{
+    const Self * self = UserData::getUserData(_lua, 1);
+    const char * tag_a = argToStringOrError(_lua, 2);
+    const char * tag_b = argToStringOrError(_lua, 3);
+    lua_pushboolean(_lua, self->getScene(_lua)->restoreTagContacts(tag_a, tag_b));
+    return 1;
+}
+
 // 1 self
 // 2 file path
 int luaApi_LoadTileMap(lua_State * _lua)
@@ -342,6 +734,91 @@ int luaApi_CreateBody(lua_State * _lua)
     return 1;
 }
 
+// 1 self
+// 2 body definition
+// 3 positions
+int luaApi_CreateBodies(lua_State * _lua)
+{
+    const Self * self = UserData::getUserData(_lua, 1);
+    std::unique_ptr<BodyDefinition> definition = tryGetBodyDefinition(_lua, 2);
+    luaL_argexpected(_lua, definition, 2, LuaTypeName::body_definition);
+    luaL_checktype(_lua, 3, LUA_TTABLE);
+    const lua_Unsigned position_count = lua_rawlen(_lua, 3);
+    std::vector<SDL_FPoint> positions(position_count);
+    for(lua_Unsigned i = 0; i < position_count; ++i)
+    {
+        lua_rawgeti(_lua, 3, i + 1);
+        luaL_argexpected(_lua, tryGetPoint(_lua, -1, positions[i]), 3, LuaTypeName::point);
+        lua_pop(_lua, 1);
+    }
+    std::vector<uint64_t> body_ids = self->getScene(_lua)->createBodies(positions, *definition);
+    lua_createtable(_lua, static_cast<int>(body_ids.size()), 0);
+    for(size_t i = 0; i < body_ids.size(); ++i)
+    {
+        lua_pushinteger(_lua, static_cast<lua_Integer>(body_ids[i]));
+        lua_rawseti(_lua, -2, i + 1);
+    }
+    return 1;
+}
+
+// 1 self
+// 2 name
+// 3 body definition
+int luaApi_CreateBodyPrototype(lua_State * _lua)
+{
+    const Self * self = UserData::getUserData(_lua, 1);
+    const char * name = argToStringOrError(_lua, 2);
+    std::unique_ptr<BodyDefinition> definition = tryGetBodyDefinition(_lua, 3);
+    luaL_argexpected(_lua, definition, 3, LuaTypeName::body_definition);
+    lua_pushinteger(_lua, static_cast<lua_Integer>(self->getScene(_lua)->createBodyPrototype(name, *definition)));
+    return 1;
+}
+
+// 1 self
+// 2 name
+int luaApi_GetBodyPrototype(lua_State * _lua)
+{
+    const Self * self = UserData::getUserData(_lua, 1);
+    const char * name = argToStringOrError(_lua, 2);
+    std::optional<uint64_t> prototype_id = self->getScene(_lua)->findBodyPrototype(name);
+    if(prototype_id.has_value())
+        lua_pushinteger(_lua, static_cast<lua_Integer>(prototype_id.value()));
+    else
+        lua_pushnil(_lua);
+    return 1;
+}
+
+// 1 self
+// 2 body prototype id or name
+// 3 position (optional)
+// 4 overrides (optional)
+int luaApi_CreateBodyFromPrototype(lua_State * _lua)
+{
+    const Self * self = UserData::getUserData(_lua, 1);
+    std::shared_ptr<Scene> scene = self->getScene(_lua);
+    std::optional<uint64_t> prototype_id;
+    if(lua_isinteger(_lua, 2))
+        prototype_id = static_cast<uint64_t>(lua_tointeger(_lua, 2));
+    else if(const char * name = argToString(_lua, 2))
+        prototype_id = scene->findBodyPrototype(name);
+    else
+        luaL_argexpected(_lua, false, 2, LuaTypeName::body_prototype);
+    SDL_FPoint position = { .0f, .0f };
+    if(!lua_isnoneornil(_lua, 3))
+        luaL_argexpected(_lua, tryGetPoint(_lua, 3, position), 3, LuaTypeName::point);
+    BodyPrototypeOverrides overrides;
+    if(!lua_isnoneornil(_lua, 4))
+        luaL_argexpected(_lua, tryGetBodyPrototypeOverrides(_lua, 4, overrides), 4, LuaTypeName::body_prototype_overrides);
+    std::optional<uint64_t> body_id = prototype_id.has_value()
+        ? scene->createBodyFromPrototype(prototype_id.value(), position, overrides)
+        : std::nullopt;
+    if(body_id.has_value())
+        pushBodyApi(_lua, scene, body_id.value());
+    else
+        lua_pushnil(_lua);
+    return 1;
+}
+
 // 1 self
 // 2 body or body id
 int luaApi_DestroyBody(lua_State * _lua)
@@ -385,6 +862,50 @@ int luaApi_CreateBodiesFromMapObjects(lua_State * _lua)
     return 0;
 }
 
+// 1 self
+// 2 layer name
+// 3 options (optional)
+int luaApi_CreateBodiesFromTileLayer(lua_State * _lua)
+{
+    const Self * self = UserData::getUserData(_lua, 1);
+    const char * layer_name = argToStringOrError(_lua, 2);
+    BodyOptions options;
+    if(!lua_isnoneornil(_lua, 3))
+        luaL_argexpected(_lua, tryGetBodyOptions(_lua, 3, options), 3, LuaTypeName::body_options);
+    lua_pushboolean(_lua, self->getScene(_lua)->createBodiesFromTileLayer(layer_name, options));
+    return 1;
+}
+
+// 1 self
+// 2 layer name
+// 3 x
+// 4 y
+// 5 tile gid
+int luaApi_SetTile(lua_State * _lua)
+{
+    const Self * self = UserData::getUserData(_lua, 1);
+    const char * layer_name = argToStringOrError(_lua, 2);
+    const int32_t x = static_cast<int32_t>(luaL_checkinteger(_lua, 3));
+    const int32_t y = static_cast<int32_t>(luaL_checkinteger(_lua, 4));
+    const uint32_t gid = static_cast<uint32_t>(luaL_checkinteger(_lua, 5));
+    lua_pushboolean(_lua, self->getScene(_lua)->setTile(layer_name, x, y, gid));
+    return 1;
+}
+
+// 1 self
+// 2 layer name
+// 3 x
+// 4 y
+int luaApi_EraseTile(lua_State * _lua)
+{
+    const Self * self = UserData::getUserData(_lua, 1);
+    const char * layer_name = argToStringOrError(_lua, 2);
+    const int32_t x = static_cast<int32_t>(luaL_checkinteger(_lua, 3));
+    const int32_t y = static_cast<int32_t>(luaL_checkinteger(_lua, 4));
+    lua_pushboolean(_lua, self->getScene(_lua)->eraseTile(layer_name, x, y));
+    return 1;
+}
+
 // 1 self
 // 2 body id or body
 int luaApi_SetFollowedBody(lua_State * _lua)
@@ -517,6 +1038,31 @@ int luaApi_UnsubscribeFromPreSolveContact(lua_State * _lua)
     return 0;
 }
 
+// 1 self
+// 2 callback
+// 3 filter (optional)
+int luaApi_SubscribeToContacts(lua_State * _lua)
+{
+    Self * self = UserData::getUserData(_lua, 1);
+    luaL_argexpected(_lua, lua_isfunction(_lua, 2), 2, LuaTypeName::function);
+    ContactFilter filter;
+    if(!lua_isnoneornil(_lua, 3))
+        luaL_argexpected(_lua, tryGetContactFilter(_lua, 3, filter), 3, LuaTypeName::contact_filter);
+    uint32_t id = self->subscribeOnContacts(_lua, filter, 2);
+    lua_pushinteger(_lua, id);
+    return 1;
+}
+
+// 1 self
+// 2 subscription ID
+int luaApi_UnsubscribeFromContacts(lua_State * _lua)
+{
+    Self * self = UserData::getUserData(_lua, 1);
+    luaL_argexpected(_lua, lua_isinteger(_lua, 2), 2, LuaTypeName::integer);
+    self->unsubscribeOnContacts(_lua, static_cast<uint32_t>(lua_tointeger(_lua, 2)));
+    return 0;
+}
+
 // 1 self
 // 2 callback
 int luaApi_SubscribeToStep(lua_State * _lua)
@@ -539,6 +1085,50 @@ int luaApi_UnsubscribeFromStep(lua_State * _lua)
     return 0;
 }
 
+// 1 self
+// 2 callback
+int luaApi_SubscribeToAnimationFrameChange(lua_State * _lua)
+{
+    Self * self = UserData::getUserData(_lua, 1);
+    luaL_argexpected(_lua, lua_isfunction(_lua, 2), 2, LuaTypeName::function);
+    uint32_t id = self->subscribeOnAnimation(_lua, gc_event_animation_frame_changed, 2);
+    lua_pushinteger(_lua, id);
+    return 1;
+}
+
+// 1 self
+// 2 subscription ID
+int luaApi_UnsubscribeFromAnimationFrameChange(lua_State * _lua)
+{
+    Self * self = UserData::getUserData(_lua, 1);
+    luaL_argexpected(_lua, lua_isinteger(_lua, 2), 2, LuaTypeName::integer);
+    uint32_t subscription_id = static_cast<uint32_t>(lua_tointeger(_lua, 2));
+    self->unsubscribeOnAnimation(_lua, gc_event_animation_frame_changed, subscription_id);
+    return 0;
+}
+
+// 1 self
+// 2 callback
+int luaApi_SubscribeToAnimationLoopEnd(lua_State * _lua)
+{
+    Self * self = UserData::getUserData(_lua, 1);
+    luaL_argexpected(_lua, lua_isfunction(_lua, 2), 2, LuaTypeName::function);
+    uint32_t id = self->subscribeOnAnimation(_lua, gc_event_animation_loop_ended, 2);
+    lua_pushinteger(_lua, id);
+    return 1;
+}
+
+// 1 self
+// 2 subscription ID
+int luaApi_UnsubscribeFromAnimationLoopEnd(lua_State * _lua)
+{
+    Self * self = UserData::getUserData(_lua, 1);
+    luaL_argexpected(_lua, lua_isinteger(_lua, 2), 2, LuaTypeName::integer);
+    uint32_t subscription_id = static_cast<uint32_t>(lua_tointeger(_lua, 2));
+    self->unsubscribeOnAnimation(_lua, gc_event_animation_loop_ended, subscription_id);
+    return 0;
+}
+
 // 1 self
 // 2 joint definition
 int luaApi_CreateDistanceJoint(lua_State * _lua)
@@ -745,10 +1335,36 @@ int luaApi_DestroyJoint(lua_State * _lua)
     return 1;
 }
 
+// 1 self
+int luaApi_Snapshot(lua_State * _lua)
+{
+    Self * self = UserData::getUserData(_lua, 1);
+    const std::vector<uint8_t> snapshot = self->getScene(_lua)->snapshot();
+    lua_pushlstring(_lua, reinterpret_cast<const char *>(snapshot.data()), snapshot.size());
+    return 1;
+}
+
+// 1 self
+// 2 snapshot
+int luaApi_Restore(lua_State * _lua)
+{
+    Self * self = UserData::getUserData(_lua, 1);
+    luaL_argexpected(_lua, lua_type(_lua, 2) == LUA_TSTRING, 2, LuaTypeName::string);
+    size_t size;
+    const char * data = lua_tolstring(_lua, 2, &size);
+    std::optional<size_t> restored_count = self->getScene(_lua)->restore(
+        std::span<const uint8_t>(reinterpret_cast<const uint8_t *>(data), size));
+    if(restored_count.has_value())
+        lua_pushinteger(_lua, static_cast<lua_Integer>(restored_count.value()));
+    else
+        lua_pushnil(_lua);
+    return 1;
+}
+
 // 1 self
 // 2 body id | body
 // 3 destination
-// TODO: options
+// 4 options (optional)
 int luaApi_FindPath(lua_State * _lua)
 {
     const Self * self = UserData::getUserData(_lua, 1);
@@ -759,20 +1375,305 @@ int luaApi_FindPath(lua_State * _lua)
         luaL_argexpected(_lua, false, 2, LuaTypeName::joinTypes(LuaTypeName::body, LuaTypeName::integer).c_str());
     SDL_FPoint destination;
     luaL_argexpected(_lua, tryGetPoint(_lua, 3, destination), 3, LuaTypeName::string);
-    auto result = self->getScene(_lua)->findPath(body_id, destination, false, false);
-    if(result.has_value())
+    AStarOptions options;
+    if(!lua_isnoneornil(_lua, 4))
+        luaL_argexpected(_lua, tryGetPathOptions(_lua, 4, options), 4, LuaTypeName::path_options);
+    bool is_complete = false;
+    auto result = self->getScene(_lua)->findPath(body_id, destination, options, &is_complete);
+    pushPath(_lua, result, is_complete);
+    return 2;
+}
+
+// 1 self
+// 2 body id | body
+// 3 destination
+// 4 options (optional)
+// 5 callback (optional)
+int luaApi_RequestPath(lua_State * _lua)
+{
+    Self * self = UserData::getUserData(_lua, 1);
+    uint64_t body_id;
+    if(lua_isinteger(_lua, 2))
+        body_id = static_cast<uint64_t>(lua_tointeger(_lua, 2));
+    else if(!tryGetBodyId(_lua, 2, &body_id))
+        luaL_argexpected(_lua, false, 2, LuaTypeName::joinTypes(LuaTypeName::body, LuaTypeName::integer).c_str());
+    SDL_FPoint destination;
+    luaL_argexpected(_lua, tryGetPoint(_lua, 3, destination), 3, LuaTypeName::point);
+    AStarOptions options;
+    if(!lua_isnoneornil(_lua, 4))
+        luaL_argexpected(_lua, tryGetPathOptions(_lua, 4, options), 4, LuaTypeName::path_options);
+    std::optional<int> callback_idx;
+    if(!lua_isnoneornil(_lua, 5))
     {
-        lua_newtable(_lua);
-        for(size_t i = 0; i < result.value().size(); ++i)
-        {
-            pushPoint(_lua, result.value()[i].x, result.value()[i].y);
-            lua_rawseti(_lua, -2, i + 1);
-        }
+        luaL_argexpected(_lua, lua_isfunction(_lua, 5), 5, LuaTypeName::function);
+        callback_idx = 5;
     }
+    std::optional<uint64_t> request_id = self->requestPath(_lua, body_id, destination, options, callback_idx);
+    if(request_id.has_value())
+        lua_pushinteger(_lua, static_cast<lua_Integer>(request_id.value()));
     else
+        lua_pushnil(_lua);
+    return 1;
+}
+
+// 1 self
+// 2 request id
+int luaApi_TakePathResult(lua_State * _lua)
+{
+    const Self * self = UserData::getUserData(_lua, 1);
+    const uint64_t request_id = static_cast<uint64_t>(luaL_checkinteger(_lua, 2));
+    std::optional<PathResult> result = self->getScene(_lua)->takePathResult(request_id);
+    if(!result.has_value())
     {
         lua_pushnil(_lua);
+        return 1;
     }
+    pushPath(_lua, result.value().points, result.value().is_complete);
+    return 2;
+}
+
+// 1 self
+// 2 request id
+int luaApi_CancelPathRequest(lua_State * _lua)
+{
+    Self * self = UserData::getUserData(_lua, 1);
+    const uint64_t request_id = static_cast<uint64_t>(luaL_checkinteger(_lua, 2));
+    lua_pushboolean(_lua, self->cancelPathRequest(_lua, request_id));
+    return 1;
+}
+
+// 1 self
+// 2 goal
+// 3 options (optional)
+int luaApi_CreateFlowField(lua_State * _lua)
+{
+    const Self * self = UserData::getUserData(_lua, 1);
+    SDL_FPoint goal;
+    luaL_argexpected(_lua, tryGetPoint(_lua, 2, goal), 2, LuaTypeName::point);
+    FlowFieldOptions options;
+    if(!lua_isnoneornil(_lua, 3))
+        luaL_argexpected(_lua, tryGetFlowFieldOptions(_lua, 3, options), 3, LuaTypeName::flow_field_options);
+    std::optional<uint64_t> id = self->getScene(_lua)->createFlowField(goal, options);
+    if(id.has_value())
+        lua_pushinteger(_lua, static_cast<lua_Integer>(id.value()));
+    else
+        lua_pushnil(_lua);
+    return 1;
+}
+
+// 1 self
+// 2 flow field id
+// 3 goal
+int luaApi_SetFlowFieldGoal(lua_State * _lua)
+{
+    const Self * self = UserData::getUserData(_lua, 1);
+    const uint64_t id = static_cast<uint64_t>(luaL_checkinteger(_lua, 2));
+    SDL_FPoint goal;
+    luaL_argexpected(_lua, tryGetPoint(_lua, 3, goal), 3, LuaTypeName::point);
+    lua_pushboolean(_lua, self->getScene(_lua)->setFlowFieldGoal(id, goal));
+    return 1;
+}
+
+// 1 self
+// 2 flow field id
+// 3 point
+int luaApi_GetFlowDirection(lua_State * _lua)
+{
+    const Self * self = UserData::getUserData(_lua, 1);
+    const uint64_t id = static_cast<uint64_t>(luaL_checkinteger(_lua, 2));
+    SDL_FPoint point;
+    luaL_argexpected(_lua, tryGetPoint(_lua, 3, point), 3, LuaTypeName::point);
+    std::optional<SDL_FPoint> direction = self->getScene(_lua)->getFlowDirection(id, point);
+    if(direction.has_value())
+        pushPoint(_lua, direction.value());
+    else
+        lua_pushnil(_lua);
+    return 1;
+}
+
+// 1 self
+// 2 flow field id
+// 3 bodies (array of body ids or bodies)
+// 4 speed
+int luaApi_ApplyFlowField(lua_State * _lua)
+{
+    const Self * self = UserData::getUserData(_lua, 1);
+    const uint64_t id = static_cast<uint64_t>(luaL_checkinteger(_lua, 2));
+    luaL_checktype(_lua, 3, LUA_TTABLE);
+    const float speed = static_cast<float>(luaL_checknumber(_lua, 4));
+    const size_t count = lua_rawlen(_lua, 3);
+    std::vector<uint64_t> body_ids;
+    body_ids.reserve(count);
+    for(size_t i = 1; i <= count; ++i)
+    {
+        lua_rawgeti(_lua, 3, static_cast<lua_Integer>(i));
+        uint64_t body_id;
+        if(lua_isinteger(_lua, -1))
+            body_ids.push_back(static_cast<uint64_t>(lua_tointeger(_lua, -1)));
+        else if(tryGetBodyId(_lua, -1, &body_id))
+            body_ids.push_back(body_id);
+        lua_pop(_lua, 1);
+    }
+    const size_t applied = self->getScene(_lua)->applyFlowField(id, body_ids, speed);
+    lua_pushinteger(_lua, static_cast<lua_Integer>(applied));
+    return 1;
+}
+
+// 1 self
+// 2 flow field id
+int luaApi_DestroyFlowField(lua_State * _lua)
+{
+    const Self * self = UserData::getUserData(_lua, 1);
+    const uint64_t id = static_cast<uint64_t>(luaL_checkinteger(_lua, 2));
+    lua_pushboolean(_lua, self->getScene(_lua)->destroyFlowField(id));
+    return 1;
+}
+
+// 1 self
+// 2 options (optional)
+int luaApi_SetActivityRegion(lua_State * _lua)
+{
+    const Self * self = UserData::getUserData(_lua, 1);
+    if(lua_isnoneornil(_lua, 2))
+    {
+        self->getScene(_lua)->resetActivityRegion();
+        return 0;
+    }
+    ActivityRegionOptions options;
+    luaL_argexpected(_lua, tryGetActivityRegionOptions(_lua, 2, options), 2, LuaTypeName::activity_region_options);
+    self->getScene(_lua)->setActivityRegion(options);
+    return 0;
+}
+
+// 1 self
+// 2 body id | body
+int luaApi_AddActivityFocus(lua_State * _lua)
+{
+    const Self * self = UserData::getUserData(_lua, 1);
+    uint64_t body_id;
+    if(lua_isinteger(_lua, 2))
+        body_id = static_cast<uint64_t>(lua_tointeger(_lua, 2));
+    else if(!tryGetBodyId(_lua, 2, &body_id))
+        luaL_argexpected(_lua, false, 2, LuaTypeName::joinTypes(LuaTypeName::body, LuaTypeName::integer).c_str());
+    lua_pushboolean(_lua, self->getScene(_lua)->addActivityFocus(body_id));
+    return 1;
+}
+
+// 1 self
+// 2 body id | body
+int luaApi_RemoveActivityFocus(lua_State * _lua)
+{
+    const Self * self = UserData::getUserData(_lua, 1);
+    uint64_t body_id;
+    if(lua_isinteger(_lua, 2))
+        body_id = static_cast<uint64_t>(lua_tointeger(_lua, 2));
+    else if(!tryGetBodyId(_lua, 2, &body_id))
+        luaL_argexpected(_lua, false, 2, LuaTypeName::joinTypes(LuaTypeName::body, LuaTypeName::integer).c_str());
+    lua_pushboolean(_lua, self->getScene(_lua)->removeActivityFocus(body_id));
+    return 1;
+}
+
+// 1 self
+// 2 body id | body
+int luaApi_IsBodyActive(lua_State * _lua)
+{
+    const Self * self = UserData::getUserData(_lua, 1);
+    uint64_t body_id;
+    if(lua_isinteger(_lua, 2))
+        body_id = static_cast<uint64_t>(lua_tointeger(_lua, 2));
+    else if(!tryGetBodyId(_lua, 2, &body_id))
+        luaL_argexpected(_lua, false, 2, LuaTypeName::joinTypes(LuaTypeName::body, LuaTypeName::integer).c_str());
+    std::optional<bool> is_active = self->getScene(_lua)->isBodyActive(body_id);
+    if(is_active.has_value())
+        lua_pushboolean(_lua, is_active.value());
+    else
+        lua_pushnil(_lua);
+    return 1;
+}
+
+// 1 self
+// 2 callback
+int luaApi_SubscribeToBodyActivity(lua_State * _lua)
+{
+    Self * self = UserData::getUserData(_lua, 1);
+    luaL_argexpected(_lua, lua_isfunction(_lua, 2), 2, LuaTypeName::function);
+    uint32_t id = self->subscribeOnBodyActivity(_lua, 2);
+    lua_pushinteger(_lua, id);
+    return 1;
+}
+
+// 1 self
+// 2 subscription ID
+int luaApi_UnsubscribeFromBodyActivity(lua_State * _lua)
+{
+    Self * self = UserData::getUserData(_lua, 1);
+    luaL_argexpected(_lua, lua_isinteger(_lua, 2), 2, LuaTypeName::integer);
+    uint32_t subscription_id = static_cast<uint32_t>(lua_tointeger(_lua, 2));
+    self->unsubscribeOnBodyActivity(_lua, subscription_id);
+    return 0;
+}
+
+template<typename Query>
+std::vector<Query> readQueries(
+    lua_State * _lua,
+    int _idx,
+    bool (* _read)(lua_State *, int, Query &),
+    const char * _type_name)
+{
+    luaL_argexpected(_lua, lua_istable(_lua, _idx), _idx, _type_name);
+    const size_t count = lua_rawlen(_lua, _idx);
+    std::vector<Query> queries(count);
+    for(size_t i = 0; i < count; ++i)
+    {
+        lua_rawgeti(_lua, _idx, static_cast<lua_Integer>(i + 1));
+        luaL_argexpected(_lua, _read(_lua, -1, queries[i]), _idx, _type_name);
+        lua_pop(_lua, 1);
+    }
+    return queries;
+}
+
+QueryOptions readQueryOptions(lua_State * _lua, int _idx)
+{
+    QueryOptions options;
+    if(!lua_isnoneornil(_lua, _idx))
+        luaL_argexpected(_lua, tryGetQueryOptions(_lua, _idx, options), _idx, LuaTypeName::query_options);
+    return options;
+}
+
+// 1 self
+// 2 rays
+// 3 options (optional)
+int luaApi_CastRays(lua_State * _lua)
+{
+    const Self * self = UserData::getUserData(_lua, 1);
+    std::vector<RayCastQuery> rays = readQueries<RayCastQuery>(_lua, 2, &tryGetRayCastQuery, LuaTypeName::ray_cast);
+    QueryOptions options = readQueryOptions(_lua, 3);
+    pushQueryHits(_lua, self->getScene(_lua)->castRays(rays, options));
+    return 1;
+}
+
+// 1 self
+// 2 shape casts
+// 3 options (optional)
+int luaApi_CastShapes(lua_State * _lua)
+{
+    const Self * self = UserData::getUserData(_lua, 1);
+    std::vector<ShapeCastQuery> casts =
+        readQueries<ShapeCastQuery>(_lua, 2, &tryGetShapeCastQuery, LuaTypeName::shape_cast);
+    QueryOptions options = readQueryOptions(_lua, 3);
+    pushQueryHits(_lua, self->getScene(_lua)->castShapes(casts, options));
+    return 1;
+}
+
+// 1 self
+// 2 rects
+// 3 options (optional)
+int luaApi_OverlapRects(lua_State * _lua)
+{
+    const Self * self = UserData::getUserData(_lua, 1);
+    std::vector<SDL_FRect> rects = readQueries<SDL_FRect>(_lua, 2, &tryGetRect, LuaTypeName::rect);
+    QueryOptions options = readQueryOptions(_lua, 3);
+    pushOverlapResults(_lua, self->getScene(_lua)->overlapRects(rects, options));
     return 1;
 }
 
@@ -788,14 +1689,26 @@ void Sol2D::Lua::pushSceneApi(lua_State * _lua, const Workspace & _workspace, st
             { "__gc", UserData::luaGC },
             { "setBackgroundColor", luaApi_SetBackgroundColor },
             { "setGravity", luaApi_SetGravity },
+            { "declareCollisionCategory", luaApi_DeclareCollisionCategory },
+            { "setOneWayNormal", luaApi_SetOneWayNormal },
+            { "removeOneWayNormal", luaApi_RemoveOneWayNormal },
+            { "ignoreTagContacts", luaApi_IgnoreTagContacts },
+            { "restoreTagContacts", luaApi_RestoreTagContacts },
             { "loadTileMap", luaApi_LoadTileMap },
             { "getTileMapObjectById", luaApi_GetTileMapObjectById },
             { "getTileMapObjectByName", luaApi_GetTileMapObjectByName },
             { "getTileMapObjectsByClass", luaApi_GetTileMapObjectsByClass },
             { "createBody", luaApi_CreateBody },
+            { "createBodies", luaApi_CreateBodies },
+            { "createBodyPrototype", luaApi_CreateBodyPrototype },
+            { "getBodyPrototype", luaApi_GetBodyPrototype },
+            { "createBodyFromPrototype", luaApi_CreateBodyFromPrototype },
             { "destroyBody", luaApi_DestroyBody },
             { "getBody", luaApi_GetBody },
             { "createBodiesFromMapObjects", luaApi_CreateBodiesFromMapObjects },
+            { "createBodiesFromTileLayer", luaApi_CreateBodiesFromTileLayer },
+            { "setTile", luaApi_SetTile },
+            { "eraseTile", luaApi_EraseTile },
             { "setFollowedBody", luaApi_SetFollowedBody },
             { "resetFollowedBody", luaApi_ResetFollowedBody },
             { "subscribeToBeginContact", luaApi_SubscribeToBeginContact },
@@ -808,8 +1721,14 @@ void Sol2D::Lua::pushSceneApi(lua_State * _lua, const Workspace & _workspace, st
             { "unsubscribeFromSesnsorEndContact", luaApi_UnsubscribeFromSesnsorEndContact },
             { "subscribeToPreSolveContact", luaApi_SubscribeToPreSolveContact },
             { "unsubscribeFromPreSolveContact", luaApi_UnsubscribeFromPreSolveContact },
+            { "subscribeToContacts", luaApi_SubscribeToContacts },
+            { "unsubscribeFromContacts", luaApi_UnsubscribeFromContacts },
             { "subscribeToStep", luaApi_SubscribeToStep },
             { "unsubscribeFromStep", luaApi_UnsubscribeFromStep },
+            { "subscribeToAnimationFrameChange", luaApi_SubscribeToAnimationFrameChange },
+            { "unsubscribeFromAnimationFrameChange", luaApi_UnsubscribeFromAnimationFrameChange },
+            { "subscribeToAnimationLoopEnd", luaApi_SubscribeToAnimationLoopEnd },
+            { "unsubscribeFromAnimationLoopEnd", luaApi_UnsubscribeFromAnimationLoopEnd },
             { "createDistanceJoint", luaApi_CreateDistanceJoint },
             { "createMotorJoint", luaApi_CreateMotorJoint },
             { "createMouseJoint", luaApi_CreateMouseJoint },
@@ -823,7 +1742,26 @@ void Sol2D::Lua::pushSceneApi(lua_State * _lua, const Workspace & _workspace, st
             { "getWeldJoint", luaApi_GetWeldJoint },
             { "getWheelJoint", luaApi_GetWheelJoint },
             { "destroyJoint", luaApi_DestroyJoint },
+            { "snapshot", luaApi_Snapshot },
+            { "restore", luaApi_Restore },
             { "findPath", luaApi_FindPath },
+            { "requestPath", luaApi_RequestPath },
+            { "takePathResult", luaApi_TakePathResult },
+            { "cancelPathRequest", luaApi_CancelPathRequest },
+            { "createFlowField", luaApi_CreateFlowField },
+            { "setFlowFieldGoal", luaApi_SetFlowFieldGoal },
+            { "getFlowDirection", luaApi_GetFlowDirection },
+            { "applyFlowField", luaApi_ApplyFlowField },
+            { "destroyFlowField", luaApi_DestroyFlowField },
+            { "setActivityRegion", luaApi_SetActivityRegion },
+            { "addActivityFocus", luaApi_AddActivityFocus },
+            { "removeActivityFocus", luaApi_RemoveActivityFocus },
+            { "isBodyActive", luaApi_IsBodyActive },
+            { "subscribeToBodyActivity", luaApi_SubscribeToBodyActivity },
+            { "unsubscribeFromBodyActivity", luaApi_UnsubscribeFromBodyActivity },
+            { "castRays", luaApi_CastRays },
+            { "castShapes", luaApi_CastShapes },
+            { "overlapRects", luaApi_OverlapRects },
             { nullptr, nullptr }
         };
         luaL_setfuncs(_lua, funcs, 0);
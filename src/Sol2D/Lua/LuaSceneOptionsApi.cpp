@@ -27,5 +27,8 @@ bool Sol2D::Lua::tryGetSceneOptions(lua_State * _lua, int _idx, SceneOptions & _
         return false;    
     table.tryGetNumber("metersPerPixel", &_options.meters_per_pixel);
     table.tryGetPoint("gravity", _options.gravity);
+    table.tryGetUnsignedInteger("physicsWorkerCount", _options.physics_worker_count);
+    table.tryGetUnsignedInteger("pathWorkerCount", &_options.path_worker_count);
+    table.tryGetUnsignedInteger("pathCompletionBudget", &_options.path_completion_budget);
     return true;
 }
@@ -0,0 +1,100 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <Sol2D/Lua/LuaSpatialQueryApi.h>
+#include <Sol2D/Lua/LuaBodyShapePhysicsDefinitionApi.h>
+#include <Sol2D/Lua/Aux/LuaTable.h>
+
+using namespace Sol2D::World;
+using namespace Sol2D::Lua;
+
+bool Sol2D::Lua::tryGetRayCastQuery(lua_State * _lua, int _idx, RayCastQuery & _query)
+{
+    LuaTable table(_lua, _idx);
+    return table.isValid() && table.tryGetPoint("from", _query.from) && table.tryGetPoint("to", _query.to);
+}
+
+bool Sol2D::Lua::tryGetShapeCastQuery(lua_State * _lua, int _idx, ShapeCastQuery & _query)
+{
+    LuaTable table(_lua, _idx);
+    if(!table.isValid() || !table.tryGetPoint("from", _query.from) || !table.tryGetPoint("to", _query.to))
+        return false;
+    float radius;
+    FSize size;
+    if(table.tryGetNumber("radius", &radius))
+        _query.geometry = CircleCastGeometry { .radius = radius };
+    else if(table.tryGetSize("size", size))
+        _query.geometry = RectCastGeometry { .w = size.w, .h = size.h };
+    else
+        return false;
+    return true;
+}
+
+bool Sol2D::Lua::tryGetQueryOptions(lua_State * _lua, int _idx, QueryOptions & _options)
+{
+    LuaTable table(_lua, _idx);
+    if(!table.isValid())
+        return false;
+    if(table.tryGetValue("filter"))
+    {
+        tryGetCollisionFilter(_lua, -1, _options.filter);
+        lua_pop(_lua, 1);
+    }
+    table.tryGetBoolean("isParallel", &_options.is_parallel);
+    return true;
+}
+
+void Sol2D::Lua::pushQueryHits(lua_State * _lua, const QueryHits & _hits)
+{
+    lua_createtable(_lua, static_cast<int>(_hits.size()), 0);
+    for(size_t i = 0; i < _hits.size(); ++i)
+    {
+        if(_hits[i].has_value())
+        {
+            const QueryHit & hit = _hits[i].value();
+            lua_createtable(_lua, 0, 7);
+            LuaTable table(_lua);
+            table.setIntegerValue("bodyId", static_cast<lua_Integer>(hit.body_id));
+            table.setStringValue("shapeKey", hit.shape_key);
+            table.setNumberValue("x", hit.point.x);
+            table.setNumberValue("y", hit.point.y);
+            table.setNumberValue("normalX", hit.normal.x);
+            table.setNumberValue("normalY", hit.normal.y);
+            table.setNumberValue("fraction", hit.fraction);
+        }
+        else
+        {
+            lua_pushboolean(_lua, false);
+        }
+        lua_rawseti(_lua, -2, static_cast<lua_Integer>(i + 1));
+    }
+}
+
+void Sol2D::Lua::pushOverlapResults(lua_State * _lua, const OverlapResults & _results)
+{
+    lua_createtable(_lua, static_cast<int>(_results.size()), 0);
+    for(size_t i = 0; i < _results.size(); ++i)
+    {
+        const std::vector<uint64_t> & body_ids = _results[i];
+        lua_createtable(_lua, static_cast<int>(body_ids.size()), 0);
+        for(size_t j = 0; j < body_ids.size(); ++j)
+        {
+            lua_pushinteger(_lua, static_cast<lua_Integer>(body_ids[j]));
+            lua_rawseti(_lua, -2, static_cast<lua_Integer>(j + 1));
+        }
+        lua_rawseti(_lua, -2, static_cast<lua_Integer>(i + 1));
+    }
+}
@@ -0,0 +1,30 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <Sol2D/World/SpatialQuery.h>
+#include <Sol2D/Lua/Aux/LuaForward.h>
+
+namespace Sol2D::Lua {
+
+bool tryGetRayCastQuery(lua_State * _lua, int _idx, World::RayCastQuery & _query);
+bool tryGetShapeCastQuery(lua_State * _lua, int _idx, World::ShapeCastQuery & _query);
+bool tryGetQueryOptions(lua_State * _lua, int _idx, World::QueryOptions & _options);
+void pushQueryHits(lua_State * _lua, const World::QueryHits & _hits);
+void pushOverlapResults(lua_State * _lua, const World::OverlapResults & _results);
+
+} // namespace Sol2D::Lua
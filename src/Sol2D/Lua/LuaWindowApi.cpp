@@ -18,6 +18,7 @@
 #include <Sol2D/Lua/LuaWindowApi.h>
 #include <Sol2D/Lua/Aux/LuaStrings.h>
 #include <Sol2D/Lua/Aux/LuaUserData.h>
+#include <Sol2D/Lua/Aux/LuaTable.h>
 
 using namespace Sol2D;
 using namespace Sol2D::Lua;
@@ -26,12 +27,14 @@ namespace {
 
 struct Self : LuaSelfBase
 {
-    explicit Self(Window & _window) :
-        window(_window)
+    Self(Window & _window, const Renderer & _renderer) :
+        window(_window),
+        renderer(_renderer)
     {
     }
 
     Window & window;
+    const Renderer & renderer;
 };
 
 using UserData = LuaUserData<Self, LuaTypeName::window>;
@@ -65,11 +68,26 @@ int luaApi_GetView(lua_State * _lua)
     return 1;
 }
 
+// 1 self
+int luaApi_GetTextureMemoryStats(lua_State * _lua)
+{
+    Self * self = UserData::getUserData(_lua, 1);
+    const TextureMemoryStats & stats = self->renderer.getTextureMemoryStats();
+    LuaTable table = LuaTable::pushNew(_lua);
+    table.setIntegerValue("budget", static_cast<lua_Integer>(stats.budget));
+    table.setIntegerValue("residentBytes", static_cast<lua_Integer>(stats.resident_bytes));
+    table.setIntegerValue("residentCount", static_cast<lua_Integer>(stats.resident_count));
+    table.setIntegerValue("evictedCount", static_cast<lua_Integer>(stats.evicted_count));
+    table.setIntegerValue("totalEvictions", static_cast<lua_Integer>(stats.total_evictions));
+    table.setIntegerValue("totalReloads", static_cast<lua_Integer>(stats.total_reloads));
+    return 1;
+}
+
 } // namespace
 
-void Sol2D::Lua::pushWindowApi(lua_State * _lua, Window & _window)
+void Sol2D::Lua::pushWindowApi(lua_State * _lua, Window & _window, const Renderer & _renderer)
 {
-    UserData::pushUserData(_lua, _window);
+    UserData::pushUserData(_lua, _window, _renderer);
     if(UserData::pushMetatable(_lua) == MetatablePushResult::Created)
     {
         luaL_Reg funcs[] =
@@ -77,6 +95,7 @@ void Sol2D::Lua::pushWindowApi(lua_State * _lua, Window & _window)
             { "__gc", UserData::luaGC },
             { "setView", luaApi_SetView },
             { "getView", luaApi_GetView },
+            { "getTextureMemoryStats", luaApi_GetTextureMemoryStats },
             { nullptr, nullptr }
         };
         luaL_setfuncs(_lua, funcs, 0);
@@ -21,6 +21,6 @@
 
 namespace Sol2D::Lua {
 
-void pushWindowApi(lua_State * _lua, Window & _window);
+void pushWindowApi(lua_State * _lua, Window & _window, const Renderer & _renderer);
 
 } // namespace Sol2D::Lua
@@ -18,6 +18,8 @@
 #include <Sol2D/MediaLayer/Primitive.h>
 #include <Sol2D/MediaLayer/SDLException.h>
 
+#include <algorithm>
+
 using namespace Sol2D;
 
 Renderer::Renderer(const ResourceManager & _resource_manager, SDL_Window * _window, SDL_GPUDevice * _device) :
@@ -34,7 +36,9 @@ Renderer::Renderer(const ResourceManager & _resource_manager, SDL_Window * _wind
     },
     mp_swapchain_texture(nullptr),
     m_rect_renderer(_resource_manager, _window, _device),
-    m_line_renderer(_resource_manager, _window, _device)
+    m_line_renderer(_resource_manager, _window, _device),
+    m_frame(0),
+    m_texture_memory_stats(std::make_shared<TextureMemoryStats>())
 {
 }
 
@@ -54,11 +58,59 @@ const FSize Renderer::getOutputSize() const
     return FSize(w, h);
 }
 
-Texture Renderer::createTexture(SDL_Surface & _surface, const char * _name) const
+Texture Renderer::createTexture(SDL_Surface & _surface, const char * _name)
+{
+    Texture texture = registerTexture(uploadTexture(_surface, _name), _surface, _name);
+    if(m_texture_memory_stats->budget)
+    {
+        // Without a source to reload from, the pixels are kept in RAM to bring the texture back after eviction
+        std::shared_ptr<SDL_Surface> cache(SDL_DuplicateSurface(&_surface), SDL_DestroySurface);
+        if(cache)
+        {
+            texture.m_state->loader = [cache]() { return cache; };
+            m_evictable_textures.push_back(texture.m_state);
+        }
+    }
+    return texture;
+}
+
+Texture Renderer::createTexture(SDL_Surface & _surface, const TextureLoader & _loader, const char * _name)
 {
+    Texture texture = registerTexture(uploadTexture(_surface, _name), _surface, _name);
+    texture.m_state->loader = _loader;
+    if(m_texture_memory_stats->budget)
+        m_evictable_textures.push_back(texture.m_state);
+    return texture;
+}
+
+Texture Renderer::registerTexture(std::shared_ptr<SDL_GPUTexture> _texture, SDL_Surface & _surface, const char * _name)
+{
+    Texture texture(_texture, FSize(_surface.w, _surface.h));
+    Texture::State & state = *texture.m_state;
+    if(_name)
+        state.name = _name;
+    state.size_in_bytes = static_cast<size_t>(_surface.w) * static_cast<size_t>(_surface.h) * 4;
+    state.last_used_frame = m_frame;
+    state.stats = m_texture_memory_stats;
+    m_texture_memory_stats->resident_bytes += state.size_in_bytes;
+    ++m_texture_memory_stats->resident_count;
+    return texture;
+}
+
+std::shared_ptr<SDL_GPUTexture> Renderer::uploadTexture(SDL_Surface & _surface, const char * _name) const
+{
+    // Indexed surfaces cannot be converted without a palette, so they still go through an intermediate surface.
     SDL_Surface * surface = &_surface;
-    if(_surface.format != SDL_PIXELFORMAT_RGBA32)
+    if(SDL_ISPIXELFORMAT_INDEXED(_surface.format))
+    {
         surface = SDL_ConvertSurface(&_surface, SDL_PIXELFORMAT_RGBA32);
+        if(!surface)
+            throw SDLException("Unable to convert surface.");
+    }
+
+    const uint32_t width = static_cast<uint32_t>(surface->w);
+    const uint32_t height = static_cast<uint32_t>(surface->h);
+    const uint32_t pitch = width * 4;
 
     SDL_GPUTexture * texture;
     {
@@ -66,8 +118,8 @@ Texture Renderer::createTexture(SDL_Surface & _surface, const char * _name) cons
         tex_create_info.type = SDL_GPU_TEXTURETYPE_2D;
         tex_create_info.format = SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM;
         tex_create_info.usage = SDL_GPU_TEXTUREUSAGE_SAMPLER;
-        tex_create_info.width = static_cast<uint32_t>(surface->w);
-        tex_create_info.height = static_cast<uint32_t>(surface->h);
+        tex_create_info.width = width;
+        tex_create_info.height = height;
         tex_create_info.layer_count_or_depth = 1;
         tex_create_info.num_levels = 1;
         texture = SDL_CreateGPUTexture(m_rendering_context.device, &tex_create_info);
@@ -84,20 +136,53 @@ Texture Renderer::createTexture(SDL_Surface & _surface, const char * _name) cons
 
     SDL_GPUTransferBuffer * tex_transfer_buffer;
     {
-        const SDL_PixelFormatDetails * surface_format = SDL_GetPixelFormatDetails(surface->format);
         SDL_GPUTransferBufferCreateInfo tex_transfer_buffer_create_info = {};
         tex_transfer_buffer_create_info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
-        tex_transfer_buffer_create_info.size = static_cast<uint32_t>(
-            surface->w * surface->h * surface_format->bytes_per_pixel);
+        tex_transfer_buffer_create_info.size = pitch * height;
         tex_transfer_buffer = SDL_CreateGPUTransferBuffer(m_rendering_context.device, &tex_transfer_buffer_create_info);
-        void * tex_transfer_ptr = SDL_MapGPUTransferBuffer(
+        Uint8 * tex_transfer_ptr = static_cast<Uint8 *>(SDL_MapGPUTransferBuffer(
             m_rendering_context.device,
             tex_transfer_buffer,
-            false);
-        memcpy(tex_transfer_ptr, surface->pixels, tex_transfer_buffer_create_info.size);
+            false));
+        const bool must_lock = SDL_MUSTLOCK(surface);
+        if(must_lock)
+            SDL_LockSurface(surface);
+        // The pixels are written straight into the mapped memory: a plain row copy for RGBA32 surfaces
+        // and a single conversion pass for any other format.
+        SDL_ConvertPixels(
+            surface->w,
+            surface->h,
+            surface->format,
+            surface->pixels,
+            surface->pitch,
+            SDL_PIXELFORMAT_RGBA32,
+            tex_transfer_ptr,
+            static_cast<int>(pitch));
+        if(must_lock)
+            SDL_UnlockSurface(surface);
+        Uint32 color_key;
+        if(surface == &_surface && SDL_GetSurfaceColorKey(surface, &color_key))
+        {
+            SDL_Color color;
+            SDL_GetRGB(
+                color_key,
+                SDL_GetPixelFormatDetails(surface->format),
+                SDL_GetSurfacePalette(surface),
+                &color.r,
+                &color.g,
+                &color.b);
+            for(Uint8 * pixel = tex_transfer_ptr, * end = tex_transfer_ptr + pitch * height; pixel != end; pixel += 4)
+            {
+                if(pixel[0] == color.r && pixel[1] == color.g && pixel[2] == color.b)
+                    pixel[3] = 0;
+            }
+        }
         SDL_UnmapGPUTransferBuffer(m_rendering_context.device, tex_transfer_buffer);
     }
 
+    if(surface != &_surface)
+        SDL_DestroySurface(surface);
+
     {
         SDL_GPUCommandBuffer * upload_cmd = SDL_AcquireGPUCommandBuffer(m_rendering_context.device);
         SDL_GPUCopyPass * upload_pass = SDL_BeginGPUCopyPass(upload_cmd);
@@ -106,8 +191,8 @@ Texture Renderer::createTexture(SDL_Surface & _surface, const char * _name) cons
         texture_transfer_src.offset = 0;
         SDL_GPUTextureRegion texture_transfer_dest = {};
         texture_transfer_dest.texture = texture;
-        texture_transfer_dest.w = static_cast<uint32_t>(surface->w);
-        texture_transfer_dest.h = static_cast<uint32_t>(surface->h);
+        texture_transfer_dest.w = width;
+        texture_transfer_dest.h = height;
         texture_transfer_dest.d = 1;
         SDL_UploadToGPUTexture(upload_pass, &texture_transfer_src, &texture_transfer_dest, false);
         SDL_EndGPUCopyPass(upload_pass);
@@ -116,10 +201,57 @@ Texture Renderer::createTexture(SDL_Surface & _surface, const char * _name) cons
 
     SDL_ReleaseGPUTransferBuffer(m_rendering_context.device, tex_transfer_buffer);
 
-    if(surface != &_surface)
-        SDL_DestroySurface(surface);
+    return SDLPtr::make(m_rendering_context.device, texture);
+}
 
-    return Texture(SDLPtr::make(m_rendering_context.device, texture), FSize(_surface.w, _surface.h));
+bool Renderer::makeTextureResident(Texture & _texture)
+{
+    Texture::State & state = *_texture.m_state;
+    state.last_used_frame = m_frame;
+    if(state.texture)
+        return true;
+    std::shared_ptr<SDL_Surface> surface = state.loader ? state.loader() : nullptr;
+    if(!surface)
+        return false;
+    state.texture = uploadTexture(*surface, state.name.empty() ? nullptr : state.name.c_str());
+    m_texture_memory_stats->resident_bytes += state.size_in_bytes;
+    ++m_texture_memory_stats->resident_count;
+    --m_texture_memory_stats->evicted_count;
+    ++m_texture_memory_stats->total_reloads;
+    return true;
+}
+
+void Renderer::evictTextures()
+{
+    TextureMemoryStats & stats = *m_texture_memory_stats;
+    if(!stats.budget || stats.resident_bytes <= stats.budget)
+        return;
+    std::erase_if(m_evictable_textures, [](const std::weak_ptr<Texture::State> & __state) { return __state.expired(); });
+    std::vector<std::shared_ptr<Texture::State>> candidates;
+    candidates.reserve(m_evictable_textures.size());
+    for(const std::weak_ptr<Texture::State> & weak_state : m_evictable_textures)
+    {
+        std::shared_ptr<Texture::State> state = weak_state.lock();
+        if(state->texture && state->last_used_frame < m_frame)
+            candidates.push_back(state);
+    }
+    std::sort(
+        candidates.begin(),
+        candidates.end(),
+        [](const std::shared_ptr<Texture::State> & __a, const std::shared_ptr<Texture::State> & __b) {
+            return __a->last_used_frame < __b->last_used_frame;
+        });
+    for(const std::shared_ptr<Texture::State> & state : candidates)
+    {
+        if(stats.resident_bytes <= stats.budget)
+            break;
+        // The device defers the actual release until the in-flight command buffers are done with the texture
+        state->texture.reset();
+        stats.resident_bytes -= state->size_in_bytes;
+        --stats.resident_count;
+        ++stats.evicted_count;
+        ++stats.total_evictions;
+    }
 }
 
 Texture Renderer::createTexture(float _width, float _height, const char * _name) const
@@ -150,6 +282,7 @@ void Renderer::beginStep()
             "It is not possible to start a new rendering step until the previous one has completed");
     }
 
+    ++m_frame;
     m_rendering_context.command_buffer = SDL_AcquireGPUCommandBuffer(m_rendering_context.device);
     if(!m_rendering_context.command_buffer)
         throw SDLException("Unable to acquire a command buffer.");
@@ -209,23 +342,30 @@ void Renderer::endRenderPass(const Texture & _texture, const SDL_FRect & _output
     m_line_renderer.endRendering();
     SDL_EndGPURenderPass(m_rendering_context.render_pass);
     m_rendering_context.render_pass = nullptr;
+    blitTexture(_texture, _output_rect);
+}
 
-    {
-        SDL_GPUBlitInfo blit_info = {};
-        blit_info.load_op = SDL_GPU_LOADOP_LOAD;
-        blit_info.source.texture = _texture.getTexture();
-        blit_info.source.x = .0f;
-        blit_info.source.y = .0f;
-        blit_info.source.w = _texture.getWidth();
-        blit_info.source.h = _texture.getHeight();
-        blit_info.destination.texture = mp_swapchain_texture;
-        blit_info.destination.x = _output_rect.x;
-        blit_info.destination.y = _output_rect.y;
-        blit_info.destination.w = _output_rect.w;
-        blit_info.destination.h = _output_rect.h;
-        blit_info.filter = SDL_GPU_FILTER_NEAREST;
-        SDL_BlitGPUTexture(m_rendering_context.command_buffer, &blit_info);
-    }
+void Renderer::blitTexture(const Texture & _texture, const SDL_FRect & _output_rect)
+{
+    if(!m_rendering_context.command_buffer)
+        throw InvalidOperationException("Rendering step not running");
+    if(m_rendering_context.render_pass)
+        throw InvalidOperationException("It is not possible to blit a texture while a render pass is running");
+
+    SDL_GPUBlitInfo blit_info = {};
+    blit_info.load_op = SDL_GPU_LOADOP_LOAD;
+    blit_info.source.texture = _texture.getTexture();
+    blit_info.source.x = .0f;
+    blit_info.source.y = .0f;
+    blit_info.source.w = _texture.getWidth();
+    blit_info.source.h = _texture.getHeight();
+    blit_info.destination.texture = mp_swapchain_texture;
+    blit_info.destination.x = _output_rect.x;
+    blit_info.destination.y = _output_rect.y;
+    blit_info.destination.w = _output_rect.w;
+    blit_info.destination.h = _output_rect.h;
+    blit_info.filter = SDL_GPU_FILTER_NEAREST;
+    SDL_BlitGPUTexture(m_rendering_context.command_buffer, &blit_info);
 }
 
 void Renderer::submitStep()
@@ -236,6 +376,7 @@ void Renderer::submitStep()
     SDL_SubmitGPUCommandBuffer(m_rendering_context.command_buffer);
     m_rendering_context.command_buffer = nullptr;
     mp_swapchain_texture = nullptr;
+    evictTextures();
 }
 
 
@@ -251,6 +392,8 @@ void Renderer::renderRect(SolidRectRenderingData && _data)
 
 void Renderer::renderTexture(TextureRenderingData && _data)
 {
+    if(_data.texture && !makeTextureResident(_data.texture))
+        return;
     m_queue.push(new TexturePrimitive(m_rect_renderer, std::forward<TextureRenderingData>(_data)));
 }
 
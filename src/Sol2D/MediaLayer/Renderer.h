@@ -30,12 +30,16 @@ public:
     Renderer(const ResourceManager & _resource_manager, SDL_Window * _window, SDL_GPUDevice * _device);
     ~Renderer();
     const FSize getOutputSize() const;
-    Texture createTexture(SDL_Surface & _surface, const char * _name = nullptr) const;
+    Texture createTexture(SDL_Surface & _surface, const char * _name = nullptr);
+    Texture createTexture(SDL_Surface & _surface, const TextureLoader & _loader, const char * _name = nullptr);
     Texture createTexture(float _width, float _height, const char * _name = nullptr) const;
+    void setTextureMemoryBudget(size_t _bytes);
+    const TextureMemoryStats & getTextureMemoryStats() const;
 
     void beginStep();
     void beginRenderPass(Texture & _texture, const SDL_FColor & _clear_color);
     void endRenderPass(const Texture & _texture, const SDL_FRect & _output_rect);
+    void blitTexture(const Texture & _texture, const SDL_FRect & _output_rect);
     void submitStep();
 
     void renderRect(RectRenderingData && _data);
@@ -49,6 +53,12 @@ public:
     void renderCapsule(CapsuleRenderingData && _data);
     void renderCapsule(SolidCapsuleRenderingData && _data);
 
+private:
+    std::shared_ptr<SDL_GPUTexture> uploadTexture(SDL_Surface & _surface, const char * _name) const;
+    Texture registerTexture(std::shared_ptr<SDL_GPUTexture> _texture, SDL_Surface & _surface, const char * _name);
+    bool makeTextureResident(Texture & _texture);
+    void evictTextures();
+
 private:
     const ResourceManager & mr_resource_manager;
     RenderingContext m_rendering_context;
@@ -56,6 +66,19 @@ private:
     RectRenderer m_rect_renderer;
     LineRenderer m_line_renderer;
     std::queue<Primitive *> m_queue;
+    uint64_t m_frame;
+    std::shared_ptr<TextureMemoryStats> m_texture_memory_stats;
+    std::vector<std::weak_ptr<Texture::State>> m_evictable_textures;
 };
 
+inline void Renderer::setTextureMemoryBudget(size_t _bytes)
+{
+    m_texture_memory_stats->budget = _bytes;
+}
+
+inline const TextureMemoryStats & Renderer::getTextureMemoryStats() const
+{
+    return *m_texture_memory_stats;
+}
+
 } // namespace Sol2D
@@ -19,11 +19,59 @@
 #include <Sol2D/MediaLayer/Size.h>
 #include <Sol2D/MediaLayer/SDLPtr.h>
 #include <Sol2D/Def.h>
+#include <functional>
+#include <string>
 
 namespace Sol2D {
 
+struct TextureMemoryStats
+{
+    TextureMemoryStats() :
+        budget(0),
+        resident_bytes(0),
+        resident_count(0),
+        evicted_count(0),
+        total_evictions(0),
+        total_reloads(0)
+    {
+    }
+
+    size_t budget;
+    size_t resident_bytes;
+    size_t resident_count;
+    size_t evicted_count;
+    uint64_t total_evictions;
+    uint64_t total_reloads;
+};
+
+using TextureLoader = std::function<std::shared_ptr<SDL_Surface>()>;
+
 class Texture final
 {
+    friend class Renderer;
+
+private:
+    struct State
+    {
+        S2_DISABLE_COPY_AND_MOVE(State)
+
+        explicit State(std::shared_ptr<SDL_GPUTexture> _texture) :
+            texture(_texture),
+            size_in_bytes(0),
+            last_used_frame(0)
+        {
+        }
+
+        ~State();
+
+        std::shared_ptr<SDL_GPUTexture> texture;
+        TextureLoader loader;
+        std::string name;
+        size_t size_in_bytes;
+        uint64_t last_used_frame;
+        std::shared_ptr<TextureMemoryStats> stats;
+    };
+
 public:
     S2_DEFAULT_COPY_AND_MOVE(Texture)
 
@@ -32,34 +80,39 @@ public:
     }
 
     Texture(std::shared_ptr<SDL_GPUTexture> _texture, const FSize & _size) :
-        m_texture(_texture),
+        m_state(_texture ? std::make_shared<State>(_texture) : nullptr),
         m_size(_size)
     {
     }
 
     operator bool() const
     {
-        return m_texture != nullptr;
+        return m_state != nullptr;
     }
 
     bool operator == (std::nullopt_t) const
     {
-        return m_texture == nullptr;
+        return m_state == nullptr;
     }
 
     bool operator != (std::nullopt_t) const
     {
-        return m_texture != nullptr;
+        return m_state != nullptr;
     }
 
     SDL_GPUTexture * getTexture() const
     {
-        return m_texture.get();
+        return m_state ? m_state->texture.get() : nullptr;
     }
 
     operator SDL_GPUTexture *() const
     {
-        return m_texture.get();
+        return getTexture();
+    }
+
+    bool isResident() const
+    {
+        return m_state && m_state->texture;
     }
 
     const FSize & getSize() const
@@ -79,14 +132,29 @@ public:
 
     void reset()
     {
-        m_texture.reset();
+        m_state.reset();
         m_size.w = .0f;
         m_size.h = .0f;
     }
 
 private:
-    std::shared_ptr<SDL_GPUTexture> m_texture;
+    std::shared_ptr<State> m_state;
     FSize m_size;
 };
 
+inline Texture::State::~State()
+{
+    if(!stats)
+        return;
+    if(texture)
+    {
+        stats->resident_bytes -= size_in_bytes;
+        --stats->resident_count;
+    }
+    else
+    {
+        --stats->evicted_count;
+    }
+}
+
 } // namespace Sol2D
@@ -15,6 +15,7 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.
 
 #include <Sol2D/MediaLayer/Utils.h>
+#include <SDL3_image/SDL_image.h>
 #include <cstring>
 
 using namespace Sol2D;
@@ -80,3 +81,19 @@ void Sol2D::detectContentRect(const SDL_Surface & _surface, SDL_Rect & _rect)
             _rect.h -= it - rows.rbegin();
     }
 }
+
+SDL_Surface * Sol2D::loadSurface(const std::filesystem::path & _path, const std::optional<SDL_Color> & _color_key)
+{
+    SDL_Surface * surface = IMG_Load(_path.c_str());
+    if(surface && _color_key.has_value())
+    {
+        const SDL_Color & color = _color_key.value();
+        const SDL_PixelFormatDetails * pixel_format = SDL_GetPixelFormatDetails(surface->format);
+        SDL_SetSurfaceColorKey(
+            surface,
+            true,
+            SDL_MapRGBA(pixel_format, nullptr, color.r, color.g, color.b, color.a)
+        );
+    }
+    return surface;
+}
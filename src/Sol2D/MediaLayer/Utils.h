@@ -18,11 +18,15 @@
 
 #include <SDL3/SDL.h>
 #include <box2d/box2d.h>
+#include <filesystem>
+#include <optional>
 
 namespace Sol2D {
 
 void detectContentRect(const SDL_Surface & _surface, SDL_Rect & _rect);
 
+SDL_Surface * loadSurface(const std::filesystem::path & _path, const std::optional<SDL_Color> & _color_key);
+
 inline const b2Vec2 & toBox2D(const SDL_FPoint & _sdl_point)
 {
     return *reinterpret_cast<const b2Vec2 *>(&_sdl_point);
@@ -63,6 +63,7 @@ void Outlet::resize()
     }
     m_canvas->reconfigure(m_rect);
     m_texture = mr_renderer.createTexture(m_rect.w, m_rect.h, "Outlet");
+    m_rendered_revision.reset();
 }
 
 void Outlet::bind(std::shared_ptr<Canvas> _canvas)
@@ -80,7 +81,17 @@ void Outlet::reconfigure(const Fragment & _fragment)
 void Outlet::step(const StepState & _state)
 {
     if(!m_canvas) return;
-    mr_renderer.beginRenderPass(m_texture, m_canvas->getClearColor());
-    m_canvas->step(_state);
-    mr_renderer.endRenderPass(m_texture, m_rect);
+    const bool is_redraw_required = m_canvas->update(_state);
+    const uint64_t revision = m_canvas->getRevision();
+    if(is_redraw_required || m_rendered_revision != revision)
+    {
+        mr_renderer.beginRenderPass(m_texture, m_canvas->getClearColor());
+        m_canvas->step(_state);
+        mr_renderer.endRenderPass(m_texture, m_rect);
+        m_rendered_revision = revision;
+    }
+    else
+    {
+        mr_renderer.blitTexture(m_texture, m_rect);
+    }
 }
@@ -19,6 +19,7 @@
 #include <Sol2D/Fragment.h>
 #include <Sol2D/Canvas.h>
 #include <Sol2D/MediaLayer/MediaLayer.h>
+#include <optional>
 
 namespace Sol2D {
 
@@ -33,11 +34,13 @@ public:
     void reconfigure(const Fragment & _fragment);
     void step(const StepState & _state);
     const Fragment & getFragment() const;
+    Canvas * getCanvas() const;
 
 private:
     Fragment m_fragment;
     Renderer & mr_renderer;
     Texture m_texture;
+    std::optional<uint64_t> m_rendered_revision; // Revision of the canvas in the texture
     SDL_FRect m_rect;
     std::shared_ptr<Canvas> m_canvas;
 };
@@ -47,4 +50,9 @@ inline const Fragment & Outlet::getFragment() const
     return m_fragment;
 }
 
+inline Canvas * Outlet::getCanvas() const
+{
+    return m_canvas.get();
+}
+
 } // namespace Sol2D
@@ -15,25 +15,17 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.
 
 #include <Sol2D/Sprite.h>
-#include <SDL3_image/SDL_image.h>
 
 using namespace Sol2D;
 
 bool Sprite::loadFromFile(const std::filesystem::path & _path, const SpriteOptions & _options /*= SpriteOptions()*/)
 {
-    SDL_Surface * surface = IMG_Load(_path.c_str());
+    std::optional<SDL_Color> color_key;
+    if(_options.color_to_alpha.has_value())
+        color_key = toR8G8B8A8_UINT(_options.color_to_alpha.value());
+    SDL_Surface * surface = loadSurface(_path, color_key);
     if(!surface)
         return false;
-    if(_options.color_to_alpha.has_value())
-    {
-        SDL_Color color = toR8G8B8A8_UINT(_options.color_to_alpha.value());
-        const SDL_PixelFormatDetails * pixel_format = SDL_GetPixelFormatDetails(surface->format);
-        SDL_SetSurfaceColorKey(
-            surface,
-            true,
-            SDL_MapRGBA(pixel_format, nullptr, color.r, color.g, color.b, color.a)
-        );
-    }
     if(_options.autodetect_rect)
     {
         SDL_Rect content_rect;
@@ -59,7 +51,10 @@ bool Sprite::loadFromFile(const std::filesystem::path & _path, const SpriteOptio
     }
     m_desination_size.w = m_source_rect.w;
     m_desination_size.h = m_source_rect.h;
-    m_texture = mp_renderer->createTexture(*surface, "Sprite");
+    m_texture = mp_renderer->createTexture(
+        *surface,
+        [_path, color_key]() { return std::shared_ptr<SDL_Surface>(loadSurface(_path, color_key), SDL_DestroySurface); },
+        "Sprite");
     SDL_DestroySurface(surface);
     return true;
 }
@@ -67,7 +62,7 @@ bool Sprite::loadFromFile(const std::filesystem::path & _path, const SpriteOptio
 void Sprite::render(
     const SDL_FPoint & _point,
     const Rotation & _rotation,
-    SDL_FlipMode _flip_mode)
+    SDL_FlipMode _flip_mode) const
 {
     if(!isValid())
         return;
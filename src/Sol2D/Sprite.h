@@ -52,7 +52,7 @@ public:
     void render(
         const SDL_FPoint & _point,
         const Rotation & _rotation,
-        SDL_FlipMode _flip_mode);
+        SDL_FlipMode _flip_mode) const;
 
 private:
     Renderer * mp_renderer;
@@ -27,20 +27,16 @@ bool SpriteSheet::loadFromFile(const std::filesystem::path & _path, const Sprite
 {
     if(!_options.row_count || !_options.col_count || !_options.sprite_width || !_options.sprite_height)
         return false;
-    SDL_Surface * surface = IMG_Load(_path.c_str());
+    std::optional<SDL_Color> color_key;
+    if(_options.color_to_alpha.has_value())
+        color_key = toR8G8B8A8_UINT(_options.color_to_alpha.value());
+    SDL_Surface * surface = loadSurface(_path, color_key);
     if(!surface)
         return false;
-    if(_options.color_to_alpha.has_value())
-    {
-        SDL_Color color = toR8G8B8A8_UINT(_options.color_to_alpha.value());
-        const SDL_PixelFormatDetails * pixel_format = SDL_GetPixelFormatDetails(surface->format);
-        SDL_SetSurfaceColorKey(
-            surface,
-            true,
-            SDL_MapRGBA(pixel_format, nullptr, color.r, color.g, color.b, color.a)
-        );
-    }
-    m_texture = mp_renderer->createTexture(*surface, "Sprite Sheet");
+    m_texture = mp_renderer->createTexture(
+        *surface,
+        [_path, color_key]() { return std::shared_ptr<SDL_Surface>(loadSurface(_path, color_key), SDL_DestroySurface); },
+        "Sprite Sheet");
     SDL_DestroySurface(surface);
     SDL_FRect rect =
     {
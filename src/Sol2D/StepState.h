@@ -50,6 +50,7 @@ struct MouseState
 
 struct StepState
 {
+    uint64_t frame; // Increases by one each step
     std::chrono::milliseconds delta_time;
     MouseState mouse_state;
 };
@@ -18,9 +18,16 @@
 
 #include <Sol2D/Tiles/TileSet.h>
 #include <Sol2D/MediaLayer/MediaLayer.h>
+#include <vector>
 
 namespace Sol2D::Tiles {
 
+// A polygon relative to the top left corner of the tile
+struct TileCollisionShape
+{
+    std::vector<SDL_FPoint> points;
+};
+
 class Tile final
 {
 public:
@@ -50,12 +57,15 @@ public:
     uint32_t getWidth() const { return m_width; }
     uint32_t getHeight() const { return m_height; }
     const Texture & getSource() const { return m_source_ptr; }
+    const std::vector<TileCollisionShape> & getCollisionShapes() const { return m_collision_shapes; }
+    void addCollisionShape(TileCollisionShape && _shape) { m_collision_shapes.push_back(std::move(_shape)); }
 
 private:
     const TileSet * mp_set;
     int32_t m_x, m_y;
     uint32_t m_width, m_height;
     Texture m_source_ptr;
+    std::vector<TileCollisionShape> m_collision_shapes;
 };
 
 } // namespace Sol2D::Tiles
@@ -21,6 +21,7 @@
 #include <cstdint>
 #include <optional>
 #include <vector>
+#include <unordered_map>
 
 namespace Sol2D::Tiles {
 
@@ -82,6 +83,8 @@ public:
     const std::optional<uint32_t> getTileGid() const { return m_tile_gid; }
     void setTileGid(uint32_t _gid) { m_tile_gid = _gid; }
     void eraseTileGid() { m_tile_gid.reset(); }
+    void setProperty(const std::string & _name, const std::string & _value) { m_properties[_name] = _value; }
+    const std::string * findProperty(const std::string & _name) const;
 
 protected:
     std::string m_class;
@@ -94,8 +97,15 @@ private:
     SDL_FPoint m_position;
     bool m_is_visible;
     std::optional<uint32_t> m_tile_gid;
+    std::unordered_map<std::string, std::string> m_properties;
 };
 
+inline const std::string * TileMapObject::findProperty(const std::string & _name) const
+{
+    auto it = m_properties.find(_name);
+    return it == m_properties.end() ? nullptr : &it->second;
+}
+
 
 class TileMapObjectWithWidthAndHeight : public TileMapObject
 {
@@ -146,6 +146,7 @@ private:
     void loadObjectLayer(const XMLElement & _xml, TileMapLayerContainer & _container, const TileMapLayer * _parent);
     void loadObject(const XMLElement & _xml, TileMapObjectLayer & _layer);
     void loadPoints(const XMLElement & _xml, TileMapPolyX & _poly);
+    void loadProperties(const XMLElement & _xml, TileMapObject & _object, const std::string & _prefix = std::string());
     void loadText(const XMLElement & _xml, TileMapText & _text);
     void loadImageLayer(const XMLElement & _xml, TileMapLayerContainer & _container, const TileMapLayer * _parent);
     void loadGroupLayer(const XMLElement & _xml, TileMapLayerContainer & _container, const TileMapLayer * _parent);
@@ -180,6 +181,7 @@ private:
                    uint32_t _spacing,
                    uint32_t _margin);
     void makeTile(const XMLElement & _xml_tile, const TileSet & _set, uint32_t _first_gid);
+    void loadTileCollisionShapes(const XMLElement & _xml_object_group, Tile & _tile);
 
 public:
     static const char * sc_root_tag_name;
@@ -387,35 +389,32 @@ bool XmlLoader::tryParseColor(const char * _value, SDL_Color & _color) const
 
 Texture XmlLoader::parseImage(const XMLElement & _xml)
 {
-    SDL_Surface * surface = nullptr;
+    std::filesystem::path path;
     if(const char * source = _xml.Attribute("source"))
     {
-        std::filesystem::path path(source);
+        path = source;
         if(path.is_relative())
             path = mr_path.parent_path() / path;
-        surface = IMG_Load(path.c_str());
-        if(surface == nullptr)
-            throw IOException(formatFileReadErrorMessage(path));
     }
     else
     {
         // TODO: load <data>
         throw NotSupportedException("Inline images are not supported yet");
     }
+    std::optional<SDL_Color> color_key;
     if(const char * trans = _xml.Attribute("trans"))
     {
         SDL_Color color;
         if(tryParseColor(trans, color))
-        {
-            const SDL_PixelFormatDetails * pixel_format = SDL_GetPixelFormatDetails(surface->format);
-            SDL_SetSurfaceColorKey(
-                surface,
-                true,
-                SDL_MapRGBA(pixel_format, nullptr, color.r, color.g, color.b, color.a)
-            );
-        }
+            color_key = color;
     }
-    Texture texture = mr_renderer.createTexture(*surface, "Tile");
+    SDL_Surface * surface = loadSurface(path, color_key);
+    if(surface == nullptr)
+        throw IOException(formatFileReadErrorMessage(path));
+    Texture texture = mr_renderer.createTexture(
+        *surface,
+        [path, color_key]() { return std::shared_ptr<SDL_Surface>(loadSurface(path, color_key), SDL_DestroySurface); },
+        "Tile");
     SDL_DestroySurface(surface);
     return texture;
 }
@@ -841,6 +840,28 @@ void TileMapXmlLoader::loadObject(const XMLElement & _xml, TileMapObjectLayer &
     }
     uint32_t gid = _xml.UnsignedAttribute("gid", UINT32_MAX);
     if(gid != UINT32_MAX)object->setTileGid(gid);
+    if(const XMLElement * xml_properties = _xml.FirstChildElement("properties"))
+        loadProperties(*xml_properties, *object);
+}
+
+// Members of class properties are flattened into dotted names, e.g. "collision.mask"
+void TileMapXmlLoader::loadProperties(const XMLElement & _xml, TileMapObject & _object, const std::string & _prefix)
+{
+    for(const XMLElement * xml_property = _xml.FirstChildElement("property");
+        xml_property;
+        xml_property = xml_property->NextSiblingElement(xml_property->Name()))
+    {
+        const char * name = readRequiredAttribute(*xml_property, "name");
+        if(const XMLElement * xml_members = xml_property->FirstChildElement("properties"))
+        {
+            loadProperties(*xml_members, _object, _prefix + name + '.');
+            continue;
+        }
+        // Multiline strings are stored as the element text
+        const char * value = xml_property->Attribute("value");
+        if(!value) value = xml_property->GetText();
+        _object.setProperty(_prefix + name, value ? value : std::string());
+    }
 }
 
 void TileMapXmlLoader::loadPoints(const XMLElement & _xml, TileMapPolyX & _poly)
@@ -1005,14 +1026,12 @@ void TileSetXmlLoader::loadFromXml(const XMLElement & _xml, uint32_t _first_gid)
         Texture texture = parseImage(*xml_image);
         makeTiles(texture, set, _first_gid, tile_width, tile_height, spacing, margin);
     }
-    else
+    // The tiles of a single image are already made, their elements only describe them
+    for(const XMLElement * xml_tile = _xml.FirstChildElement("tile");
+         xml_tile;
+         xml_tile = xml_tile->NextSiblingElement(xml_tile->Name()))
     {
-        for(const XMLElement * xml_tile = _xml.FirstChildElement("tile");
-             xml_tile;
-             xml_tile = xml_tile->NextSiblingElement(xml_tile->Name()))
-        {
-            makeTile(*xml_tile, set, _first_gid);
-        }
+        makeTile(*xml_tile, set, _first_gid);
     }
 
     // TODO: <tileoffset>
@@ -1051,6 +1070,7 @@ void TileSetXmlLoader::makeTile(const XMLElement & _xml_tile, const TileSet & _s
     uint32_t y = _xml_tile.UnsignedAttribute("y");
     uint32_t width = _xml_tile.UnsignedAttribute("width");
     uint32_t height = _xml_tile.UnsignedAttribute("height");
+    Tile * tile = nullptr;
     if(const XMLElement * xml_image = _xml_tile.FirstChildElement("image"))
     {
         Texture texture = parseImage(*xml_image);
@@ -1059,8 +1079,14 @@ void TileSetXmlLoader::makeTile(const XMLElement & _xml_tile, const TileSet & _s
             width = static_cast<uint32_t>(texture.getWidth());
             height = static_cast<uint32_t>(texture.getHeight());
         }
-        mr_tile_heap.createTile(gid, _set, texture, x, y, width, height);
+        tile = mr_tile_heap.createTile(gid, _set, texture, x, y, width, height);
+    }
+    else
+    {
+        tile = mr_tile_heap.getTile(gid);
     }
+    if(const XMLElement * xml_object_group = _xml_tile.FirstChildElement("objectgroup"); tile && xml_object_group)
+        loadTileCollisionShapes(*xml_object_group, *tile);
 
     // TODO: type: The class of the tile. Is inherited by tile objects.
     //       (since 1.0, defaults to “”, was saved as class in 1.9)
@@ -1071,10 +1097,70 @@ void TileSetXmlLoader::makeTile(const XMLElement & _xml_tile, const TileSet & _s
     //       others while editing with the terrain tool. (defaults to 0)
 
     // TODO: <properties>
-    // TODO: <objectgroup>
     // TODO: <animation>
 }
 
+// Only rectangles and polygons are supported
+void TileSetXmlLoader::loadTileCollisionShapes(const XMLElement & _xml_object_group, Tile & _tile)
+{
+    for(const XMLElement * xml_object = _xml_object_group.FirstChildElement("object");
+        xml_object;
+        xml_object = xml_object->NextSiblingElement(xml_object->Name()))
+    {
+        if(xml_object->FirstChildElement("ellipse") ||
+            xml_object->FirstChildElement("point") ||
+            xml_object->FirstChildElement("polyline"))
+        {
+            continue;
+        }
+        const float x = xml_object->FloatAttribute("x");
+        const float y = xml_object->FloatAttribute("y");
+        TileCollisionShape shape;
+        if(const XMLElement * xml_polygon = xml_object->FirstChildElement("polygon"))
+        {
+            const char * points = readRequiredAttribute(*xml_polygon, "points");
+            if(!points)
+                continue;
+            std::stringstream ss(points);
+            std::string point_str;
+            while(ss >> point_str)
+            {
+                size_t del_pos = point_str.find(',', 0);
+                if(del_pos != std::string::npos)
+                {
+                    shape.points.push_back(
+                    {
+                        .x = std::strtof(point_str.c_str(), nullptr),
+                        .y = std::strtof(&point_str.c_str()[del_pos + 1], nullptr)
+                    });
+                }
+            }
+            if(shape.points.size() < 3)
+                continue;
+        }
+        else
+        {
+            const float width = xml_object->FloatAttribute("width");
+            const float height = xml_object->FloatAttribute("height");
+            if(width <= .0f || height <= .0f)
+                continue;
+            shape.points = { { .0f, .0f }, { width, .0f }, { width, height }, { .0f, height } };
+        }
+        if(const float angle = xml_object->FloatAttribute("rotation"))
+        {
+            Rotation rotation(degreesToRadians(angle), Rotation::AngleUnit::Radian);
+            for(SDL_FPoint & point : shape.points)
+                point = rotation.rotateVectorCCW(point);
+        }
+        for(SDL_FPoint & point : shape.points)
+        {
+            point.x += x;
+            point.y += y;
+        }
+        _tile.addCollisionShape(std::move(shape));
+    }
+}
+
 Tmx Sol2D::Tiles::loadTmx(Renderer & _renderer, const Workspace & _workspace, const std::filesystem::path & _path)
 {
     std::unique_ptr<TileHeap> tile_heap(new TileHeap);
@@ -0,0 +1,128 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <Sol2D/Def.h>
+#include <vector>
+#include <string>
+#include <span>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+
+namespace Sol2D::Utils {
+
+template<typename T>
+concept BinaryStreamValue = std::is_trivially_copyable_v<T>;
+
+class BinaryWriter final
+{
+public:
+    S2_DISABLE_COPY_AND_MOVE(BinaryWriter)
+
+    explicit BinaryWriter(std::vector<uint8_t> & _buffer) :
+        mr_buffer(_buffer)
+    {
+    }
+
+    template<BinaryStreamValue T>
+    void write(const T & _value);
+
+    template<BinaryStreamValue T>
+    void writeAt(size_t _offset, const T & _value);
+
+    void writeString(const std::string & _value);
+    size_t getOffset() const;
+
+private:
+    std::vector<uint8_t> & mr_buffer;
+};
+
+template<BinaryStreamValue T>
+inline void BinaryWriter::write(const T & _value)
+{
+    const size_t offset = mr_buffer.size();
+    mr_buffer.resize(offset + sizeof(T));
+    std::memcpy(mr_buffer.data() + offset, &_value, sizeof(T));
+}
+
+template<BinaryStreamValue T>
+inline void BinaryWriter::writeAt(size_t _offset, const T & _value)
+{
+    std::memcpy(mr_buffer.data() + _offset, &_value, sizeof(T));
+}
+
+inline void BinaryWriter::writeString(const std::string & _value)
+{
+    write(static_cast<uint32_t>(_value.size()));
+    mr_buffer.insert(mr_buffer.end(), _value.begin(), _value.end());
+}
+
+inline size_t BinaryWriter::getOffset() const
+{
+    return mr_buffer.size();
+}
+
+class BinaryReader final
+{
+public:
+    S2_DISABLE_COPY_AND_MOVE(BinaryReader)
+
+    explicit BinaryReader(std::span<const uint8_t> _data) :
+        m_data(_data),
+        m_offset(0)
+    {
+    }
+
+    template<BinaryStreamValue T>
+    bool read(T & _value);
+
+    bool readString(std::string & _value);
+    bool isAtEnd() const;
+
+private:
+    std::span<const uint8_t> m_data;
+    size_t m_offset;
+};
+
+template<BinaryStreamValue T>
+inline bool BinaryReader::read(T & _value)
+{
+    if(m_data.size() - m_offset < sizeof(T))
+        return false;
+    std::memcpy(&_value, m_data.data() + m_offset, sizeof(T));
+    m_offset += sizeof(T);
+    return true;
+}
+
+inline bool BinaryReader::readString(std::string & _value)
+{
+    uint32_t size;
+    if(!read(size) || m_data.size() - m_offset < size)
+        return false;
+    _value.assign(reinterpret_cast<const char *>(m_data.data() + m_offset), size);
+    m_offset += size;
+    return true;
+}
+
+inline bool BinaryReader::isAtEnd() const
+{
+    return m_offset == m_data.size();
+}
+
+} // namespace Sol2D::Utils
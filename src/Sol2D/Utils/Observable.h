@@ -43,6 +43,7 @@ protected:
     template<ObserverMethodConcept Method, typename ...Args>
     void callObservers(Method _method, Args ... _args);
     void forEachObserver(std::function<bool(Observer &)> _callback);
+    bool hasObservers() const;
 
 private:
     void modifyObserverCollection(std::function<void(ObserverList&)> _callback);
@@ -108,4 +109,10 @@ void Observable<Observer>::forEachObserver(std::function<bool(Observer &)> _call
     }
 }
 
+template<typename Observer>
+bool Observable<Observer>::hasObservers() const
+{
+    return !m_observers.load(std::memory_order::acquire)->empty();
+}
+
 } // namespace Sol2D::Utils
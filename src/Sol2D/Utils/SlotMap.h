@@ -0,0 +1,215 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <Sol2D/Def.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace Sol2D::Utils {
+
+// Stores objects in fixed-size chunks, so addresses stay stable while the storage grows.
+// A handle combines a slot index with the slot generation, stale handles never resolve.
+// The object receives its own handle as the first constructor argument.
+template<typename T, size_t chunk_size = 256>
+class SlotMap final
+{
+    S2_DISABLE_COPY_AND_MOVE(SlotMap)
+
+public:
+    using Handle = uint64_t;
+
+    static constexpr Handle null_handle = 0;
+
+public:
+    SlotMap();
+    ~SlotMap();
+    template<typename... Args>
+    T & emplace(Args && ... _args);
+    T * find(Handle _handle);
+    const T * find(Handle _handle) const;
+    bool contains(Handle _handle) const;
+    bool erase(Handle _handle);
+    void clear();
+    size_t getSize() const;
+    bool isEmpty() const;
+    template<typename Callback>
+    void forEach(Callback _callback);
+
+private:
+    struct Slot
+    {
+        alignas(T) std::byte storage[sizeof(T)];
+        uint32_t generation = 1;
+        bool is_occupied = false;
+
+        T * get()
+        {
+            return std::launder(reinterpret_cast<T *>(storage));
+        }
+    };
+
+    using Chunk = std::array<Slot, chunk_size>;
+
+private:
+    static Handle makeHandle(uint32_t _index, uint32_t _generation);
+    Slot & getSlot(uint32_t _index) const;
+    Slot * findSlot(Handle _handle) const;
+
+private:
+    static constexpr uint32_t s_max_generation = 0x7FFFFFFF;
+    std::vector<std::unique_ptr<Chunk>> m_chunks;
+    std::vector<uint32_t> m_free_indices;
+    uint32_t m_slot_count;
+    size_t m_size;
+};
+
+template<typename T, size_t chunk_size>
+SlotMap<T, chunk_size>::SlotMap() :
+    m_slot_count(0),
+    m_size(0)
+{
+}
+
+template<typename T, size_t chunk_size>
+SlotMap<T, chunk_size>::~SlotMap()
+{
+    clear();
+}
+
+template<typename T, size_t chunk_size>
+inline typename SlotMap<T, chunk_size>::Handle SlotMap<T, chunk_size>::makeHandle(uint32_t _index, uint32_t _generation)
+{
+    return (static_cast<Handle>(_generation) << 32) | _index;
+}
+
+template<typename T, size_t chunk_size>
+inline typename SlotMap<T, chunk_size>::Slot & SlotMap<T, chunk_size>::getSlot(uint32_t _index) const
+{
+    return (*m_chunks[_index / chunk_size])[_index % chunk_size];
+}
+
+template<typename T, size_t chunk_size>
+inline typename SlotMap<T, chunk_size>::Slot * SlotMap<T, chunk_size>::findSlot(Handle _handle) const
+{
+    const uint32_t index = static_cast<uint32_t>(_handle & 0xFFFFFFFF);
+    if(index >= m_slot_count)
+        return nullptr;
+    Slot & slot = getSlot(index);
+    return slot.is_occupied && slot.generation == static_cast<uint32_t>(_handle >> 32) ? &slot : nullptr;
+}
+
+template<typename T, size_t chunk_size>
+template<typename... Args>
+T & SlotMap<T, chunk_size>::emplace(Args && ... _args)
+{
+    uint32_t index;
+    if(m_free_indices.empty())
+    {
+        if(m_slot_count == m_chunks.size() * chunk_size)
+            m_chunks.push_back(std::make_unique<Chunk>());
+        index = m_slot_count;
+    }
+    else
+    {
+        index = m_free_indices.back();
+    }
+    Slot & slot = getSlot(index);
+    T * object = new(slot.storage) T(makeHandle(index, slot.generation), std::forward<Args>(_args)...);
+    if(m_free_indices.empty())
+        ++m_slot_count;
+    else
+        m_free_indices.pop_back();
+    slot.is_occupied = true;
+    ++m_size;
+    return *object;
+}
+
+template<typename T, size_t chunk_size>
+inline T * SlotMap<T, chunk_size>::find(Handle _handle)
+{
+    Slot * slot = findSlot(_handle);
+    return slot ? slot->get() : nullptr;
+}
+
+template<typename T, size_t chunk_size>
+inline const T * SlotMap<T, chunk_size>::find(Handle _handle) const
+{
+    Slot * slot = findSlot(_handle);
+    return slot ? slot->get() : nullptr;
+}
+
+template<typename T, size_t chunk_size>
+inline bool SlotMap<T, chunk_size>::contains(Handle _handle) const
+{
+    return findSlot(_handle) != nullptr;
+}
+
+template<typename T, size_t chunk_size>
+bool SlotMap<T, chunk_size>::erase(Handle _handle)
+{
+    Slot * slot = findSlot(_handle);
+    if(!slot)
+        return false;
+    slot->is_occupied = false;
+    slot->generation = slot->generation == s_max_generation ? 1 : slot->generation + 1;
+    slot->get()->~T();
+    m_free_indices.push_back(static_cast<uint32_t>(_handle & 0xFFFFFFFF));
+    --m_size;
+    return true;
+}
+
+template<typename T, size_t chunk_size>
+void SlotMap<T, chunk_size>::clear()
+{
+    for(uint32_t index = 0; index < m_slot_count; ++index)
+    {
+        Slot & slot = getSlot(index);
+        if(slot.is_occupied)
+            erase(makeHandle(index, slot.generation));
+    }
+}
+
+template<typename T, size_t chunk_size>
+inline size_t SlotMap<T, chunk_size>::getSize() const
+{
+    return m_size;
+}
+
+template<typename T, size_t chunk_size>
+inline bool SlotMap<T, chunk_size>::isEmpty() const
+{
+    return m_size == 0;
+}
+
+template<typename T, size_t chunk_size>
+template<typename Callback>
+void SlotMap<T, chunk_size>::forEach(Callback _callback)
+{
+    for(uint32_t index = 0; index < m_slot_count; ++index)
+    {
+        Slot & slot = getSlot(index);
+        if(slot.is_occupied)
+            _callback(*slot.get());
+    }
+}
+
+} // namespace Sol2D::Utils
@@ -91,8 +91,35 @@ void View::resize()
         pair.second->resize();
 }
 
+void View::simulate(const StepState & _state, World::Box2dTaskSystem & _task_system)
+{
+    m_simulated_canvases.clear();
+    for(const Outlet * outlet : m_ordered_outlets)
+    {
+        Canvas * canvas = outlet->getCanvas();
+        // The same canvas can be bound to several fragments
+        if(!canvas || std::find(m_simulated_canvases.begin(), m_simulated_canvases.end(), canvas) !=
+            m_simulated_canvases.end())
+        {
+            continue;
+        }
+        if(canvas->beginSimulation(_state))
+            m_simulated_canvases.push_back(canvas);
+    }
+    if(m_simulated_canvases.empty())
+        return;
+    std::pair<const StepState *, Canvas **> context(&_state, m_simulated_canvases.data());
+    b2TaskCallback * callback = [](int32_t __start, int32_t __end, uint32_t, void * __context) {
+        auto * context = static_cast<std::pair<const StepState *, Canvas **> *>(__context);
+        for(int32_t i = __start; i < __end; ++i)
+            context->second[i]->simulate(*context->first);
+    };
+    _task_system.execute(callback, static_cast<int32_t>(m_simulated_canvases.size()), 1, &context);
+}
+
 void View::step(const StepState & _state)
 {
-    for(auto & pair : m_outlets)
-        pair.second->step(_state);
+    // Callbacks of the canvases are dispatched in the order of fragments to be the same from step to step
+    for(Outlet * outlet : m_ordered_outlets)
+        outlet->step(_state);
 }
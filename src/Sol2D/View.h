@@ -18,6 +18,7 @@
 
 #include <Sol2D/StepState.h>
 #include <Sol2D/Outlet.h>
+#include <Sol2D/World/Box2dTaskSystem.h>
 #include <unordered_map>
 #include <list>
 
@@ -35,6 +36,7 @@ public:
     bool deleteFragment(uint16_t _id);
     bool bindFragment(uint16_t _fragment_id, std::shared_ptr<Canvas> _canvas);
     void resize();
+    void simulate(const StepState & _state, World::Box2dTaskSystem & _task_system);
     void step(const StepState & _state);
 
 private:
@@ -46,6 +48,7 @@ private:
     std::unordered_map<uint16_t, std::unique_ptr<Outlet>> m_outlets;
     uint16_t m_next_fragment_id;
     std::list<Outlet *> m_ordered_outlets;
+    std::vector<Canvas *> m_simulated_canvases;
 };
 
 inline View::View(Renderer & _renderer) :
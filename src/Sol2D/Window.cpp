@@ -23,5 +23,7 @@ void Window::step(const StepState & _state)
     if(m_view_list.empty())
         return;
     m_view_list.resize(1);
+    if(m_scene_task_system_ptr)
+        m_view_list.back()->simulate(_state, *m_scene_task_system_ptr);
     m_view_list.back()->step(_state);
 }
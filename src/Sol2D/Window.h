@@ -17,6 +17,7 @@
 #pragma once
 
 #include <Sol2D/View.h>
+#include <Sol2D/World/Box2dTaskSystem.h>
 #include <memory>
 #include <list>
 
@@ -27,7 +28,7 @@ class Window final
     S2_DISABLE_COPY_AND_MOVE(Window)
 
 public:
-    Window();
+    explicit Window(uint32_t _scene_worker_count = 1);
     void step(const StepState & _state);
     void setView(std::shared_ptr<View> _view);
     std::shared_ptr<View> getView() const;
@@ -39,10 +40,14 @@ private:
     // Instead, we add the new view to the list and continue using the old view until the next step.
     // The list is truncated before each step.
     std::list<std::shared_ptr<View>> m_view_list;
+    // Steps worlds of the scenes concurrently, null if the scenes are stepped one by one
+    std::unique_ptr<World::Box2dTaskSystem> m_scene_task_system_ptr;
 };
 
-inline Window:: Window()
+inline Window::Window(uint32_t _scene_worker_count)
 {
+    if(_scene_worker_count > 1)
+        m_scene_task_system_ptr = std::make_unique<World::Box2dTaskSystem>(_scene_worker_count);
 }
 
 inline void Window::setView(std::shared_ptr<View> _view)
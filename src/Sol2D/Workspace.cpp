@@ -17,6 +17,7 @@
 #include <Sol2D/Workspace.h>
 #include <tinyxml2.h>
 #include <spdlog/sinks/stdout_sinks.h>
+#include <thread>
 
 using namespace Sol2D;
 using namespace tinyxml2;
@@ -25,6 +26,9 @@ namespace fs = std::filesystem;
 
 Workspace::Workspace() :
     m_frame_rate(60),
+    m_texture_memory_budget(0),
+    m_physics_worker_count(1),
+    m_scene_worker_count(1),
     m_is_debug_rendering_enabled(false),
     m_main_logger_ptr (spdlog::stdout_logger_mt("engine")),
     m_lua_logger_ptr(spdlog::stdout_logger_mt("application"))
@@ -60,6 +64,24 @@ std::unique_ptr<Workspace> Workspace::load(const std::filesystem::path & _config
                 if(frame_rate < UINT16_MAX)
                     workspace->m_frame_rate = static_cast<uint16_t>(frame_rate);
             }
+            // The budget is set in megabytes, 0 means no limit
+            workspace->m_texture_memory_budget =
+                static_cast<size_t>(xgraphics->UnsignedAttribute("texture-budget", 0)) * 1024 * 1024;
+        }
+        if(const XMLElement * xphysics = xengine->FirstChildElement("physics"))
+        {
+            // 0 means one worker per logical CPU core
+            uint32_t worker_count = xphysics->UnsignedAttribute("workers", 1);
+            if(worker_count == 0)
+                worker_count = std::max(1u, std::thread::hardware_concurrency());
+            workspace->m_physics_worker_count = worker_count;
+            // Worlds of different scenes are stepped concurrently if there is more than one scene worker.
+            // Each world uses its own physics workers which spin while waiting for tasks,
+            // so scene workers multiplied by physics workers should not exceed the CPU cores.
+            uint32_t scene_worker_count = xphysics->UnsignedAttribute("scene-workers", 1);
+            if(scene_worker_count == 0)
+                scene_worker_count = std::max(1u, std::thread::hardware_concurrency());
+            workspace->m_scene_worker_count = scene_worker_count;
         }
         if(const XMLElement * xlogging = xengine->FirstChildElement("logging"))
         {
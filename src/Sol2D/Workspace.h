@@ -53,6 +53,21 @@ public:
         return m_frame_rate;
     }
 
+    size_t getTextureMemoryBudget() const
+    {
+        return m_texture_memory_budget;
+    }
+
+    uint32_t getPhysicsWorkerCount() const
+    {
+        return m_physics_worker_count;
+    }
+
+    uint32_t getSceneWorkerCount() const
+    {
+        return m_scene_worker_count;
+    }
+
     bool isDebugRenderingEnabled() const
     {
         return m_is_debug_rendering_enabled;
@@ -92,6 +107,9 @@ private:
     std::filesystem::path m_scripts_directory;
     std::filesystem::path m_resources_directory;
     uint16_t m_frame_rate;
+    size_t m_texture_memory_budget;
+    uint32_t m_physics_worker_count;
+    uint32_t m_scene_worker_count;
     bool m_is_debug_rendering_enabled;
     std::shared_ptr<spdlog::logger> m_main_logger_ptr;
     std::shared_ptr<spdlog::logger> m_lua_logger_ptr;
@@ -15,266 +15,183 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.
 
 #include <Sol2D/World/AStar.h>
-#include <cmath>
-#include <map>
-#include <stack>
+#include <algorithm>
 
 using namespace Sol2D;
 using namespace Sol2D::World;
 
-namespace {
-
-struct MatrixIndex
-{
-    int32_t x, y;
-};
-
-union Index
-{
-    int64_t map_key;
-    MatrixIndex matrix_index;
-};
-
-struct Node
-{
-    int32_t x, y;
-    uint32_t cost;
-    Index index;
-    const Node * prev;
-};
-
-class AStar final
-{
-public:
-    AStar(
-        b2WorldId _world_id,
-        b2BodyId _body_id,
-        const b2Vec2 & _destination,
-        const AStarOptions & _options);
-    ~AStar();
-    std::optional<std::vector<b2Vec2>> exec();
-
-private:
-    static b2Vec2 calculateCellSize(b2BodyId _body_id);
-    void emplaceSuccessors(const Node & _node);
-    void emplaceNode(int32_t _x, int32_t _y, const Node & _parent_node);
-    bool isDestination(const b2Vec2 & _point) const;
-    bool isDeadEnd(const b2Vec2 & _point) const;
-    std::vector<b2Vec2> translatePath(const Node & _end_node) const;
-    static float getDistance(const b2Vec2 & _p1, const b2Vec2 & _p2);
-    static bool arePointsInRow(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3);
-
-private:
-    static const uint16_t s_step_cost = 1;
-    b2WorldId m_world_id;
-    b2BodyId m_body_id;
-    const b2Vec2 m_start_point;
-    const b2Vec2 & mr_dest_point;
-    const b2Vec2 m_cell_size;
-    const AStarOptions & mr_options;
-    std::map<int64_t, Node *> m_known_nodes;
-    std::multimap<float, Node *> m_open_nodes;
-};
-
-} // namespace
-
-AStar::AStar(
-    b2WorldId _world_id,
-    b2BodyId _body_id,
+std::optional<AStarResult> AStar::findPath(
+    OccupancyGrid & _grid,
+    const b2Vec2 & _start,
     const b2Vec2 & _destination,
-    const AStarOptions & _options
-) :
-    m_world_id(_world_id),
-    m_body_id(_body_id),
-    m_start_point(b2Body_GetPosition(m_body_id)),
-    mr_dest_point(_destination),
-    m_cell_size(calculateCellSize(_body_id)),
-    mr_options(_options)
+    const AStarOptions & _options)
 {
-    Node * root = new Node
-    {
-        .x = 0,
-        .y = 0,
-        .cost = 0,
-        .index = { .map_key = 0 },
-        .prev = nullptr
-    };
-    m_known_nodes.emplace(0, root);
-    m_open_nodes.emplace(.0f, root);
+    const CellPoint from { .x = _grid.getCellX(_start.x), .y = _grid.getCellY(_start.y) };
+    const CellPoint to { .x = _grid.getCellX(_destination.x), .y = _grid.getCellY(_destination.y) };
+    m_allow_diagonal_steps = _options.allow_diagonal_steps;
+    mp_bounds = nullptr;
+    uint32_t end_index;
+    const bool is_complete = search(_grid, from, to, _options.max_expansions, end_index);
+    if(!is_complete && !_options.allow_partial_path)
+        return std::nullopt;
+    m_cells.clear();
+    collectCells(end_index, m_cells);
+    return AStarResult { .points = makeWaypoints(_grid, _start, m_cells), .is_complete = is_complete };
 }
 
-AStar::~AStar()
-{
-    for(const auto & pair : m_known_nodes)
-        delete pair.second;
+bool AStar::findCellPath(
+    OccupancyGrid & _grid,
+    const CellPoint & _from,
+    const CellPoint & _to,
+    const CellRect & _bounds,
+    bool _allow_diagonal_steps,
+    std::vector<CellPoint> & _path)
+{
+    m_allow_diagonal_steps = _allow_diagonal_steps;
+    mp_bounds = &_bounds;
+    uint32_t end_index;
+    // Each cell of the bounds is expanded once at most
+    const uint32_t max_expansions = static_cast<uint32_t>(_bounds.w) * static_cast<uint32_t>(_bounds.h);
+    const bool is_found = search(_grid, _from, _to, max_expansions, end_index);
+    mp_bounds = nullptr;
+    if(!is_found)
+        return false;
+    const size_t offset = _path.size();
+    collectCells(end_index, _path);
+    _path.erase(_path.begin() + offset); // The first cell is already in the path
+    return true;
 }
 
-b2Vec2 AStar::calculateCellSize(b2BodyId _body_id)
-{
-    int shape_count = b2Body_GetShapeCount(_body_id);
-    if(shape_count == 0)
-    {
-        return { .x = 1.0f, .y = 1.0f };
-    }
-    std::vector<b2ShapeId> shape_ids(shape_count);
-    b2Body_GetShapes(_body_id, shape_ids.data(), shape_count);
-    std::optional<b2AABB> body_aabb;
-    for(int i = 0; i < shape_count; ++i)
+bool AStar::search(
+    OccupancyGrid & _grid,
+    const CellPoint & _from,
+    const CellPoint & _to,
+    uint32_t _max_expansions,
+    uint32_t & _end_index)
+{
+    m_destination = _to;
+    m_nodes.clear();
+    m_node_indices.clear();
+    m_open_nodes.clear();
+    m_nodes.push_back(Node { .cell = _from, .cost = .0f, .parent = s_no_parent, .is_closed = false });
+    m_node_indices.tryEmplace(OccupancyGrid::makeCellKey(_from.x, _from.y), 0);
+    m_open_nodes.push_back(OpenNode { .full_cost = estimate(_from, _to, m_allow_diagonal_steps), .index = 0 });
+
+    _end_index = 0;
+    float closest_estimate = m_open_nodes.front().full_cost;
+    uint32_t expansion_count = 0;
+    while(!m_open_nodes.empty())
     {
-        if(!b2Shape_IsSensor(shape_ids[i])) // TODO: from user options
+        std::pop_heap(m_open_nodes.begin(), m_open_nodes.end());
+        const uint32_t index = m_open_nodes.back().index;
+        m_open_nodes.pop_back();
+        Node & node = m_nodes[index];
+        if(node.is_closed)
+            continue; // A stale entry left after the cost of the node was lowered
+        node.is_closed = true;
+        if(node.cell == _to)
         {
-            if(body_aabb.has_value())
-                body_aabb = b2AABB_Union(body_aabb.value(), b2Shape_GetAABB(shape_ids[i]));
-            else
-                body_aabb = b2Shape_GetAABB(shape_ids[i]);
+            _end_index = index;
+            return true;
         }
+        const float node_estimate = estimate(node.cell, _to, m_allow_diagonal_steps);
+        if(node_estimate < closest_estimate)
+        {
+            closest_estimate = node_estimate;
+            _end_index = index;
+        }
+        if(++expansion_count > _max_expansions)
+            break;
+        expandNode(index, _grid);
     }
-    if(body_aabb.has_value())
-    {
-        return b2Vec2(
-            std::abs(body_aabb.value().upperBound.x - body_aabb.value().lowerBound.x),
-            std::abs(body_aabb.value().upperBound.y - body_aabb.value().lowerBound.y)
-        );
-    }
-    else
-    {
-        return { .x = 1.0f, .y = 1.0f };
-    }
+    return false;
 }
 
-std::optional<std::vector<b2Vec2>> AStar::exec()
-{
-    b2Vec2 position;
-    while(!m_open_nodes.empty()) // TODO: a potentially endless loop, must be a limit (?)
-    {
-        const auto item = m_open_nodes.extract(m_open_nodes.begin());
-        const Node * node = item.mapped();
-        position.x = m_start_point.x + node->x * m_cell_size.x;
-        position.y = m_start_point.y + node->y * m_cell_size.y;
-        if(isDestination(position))
-            return translatePath(*node);
-        if(!isDeadEnd(position))
-            emplaceSuccessors(*node);
-    }
-    return std::nullopt;
+void AStar::expandNode(uint32_t _index, OccupancyGrid & _grid)
+{
+    const int32_t x = m_nodes[_index].cell.x;
+    const int32_t y = m_nodes[_index].cell.y;
+    const float cost = m_nodes[_index].cost;
+    const bool is_left_free = isPassable(_grid, x - 1, y);
+    const bool is_right_free = isPassable(_grid, x + 1, y);
+    const bool is_top_free = isPassable(_grid, x, y - 1);
+    const bool is_bottom_free = isPassable(_grid, x, y + 1);
+    if(is_left_free) relaxNode(x - 1, y, cost + straight_step_cost, _index);
+    if(is_right_free) relaxNode(x + 1, y, cost + straight_step_cost, _index);
+    if(is_top_free) relaxNode(x, y - 1, cost + straight_step_cost, _index);
+    if(is_bottom_free) relaxNode(x, y + 1, cost + straight_step_cost, _index);
+    if(!m_allow_diagonal_steps)
+        return;
+    // Diagonal steps must not cut the corners of obstacles
+    if(is_left_free && is_top_free && isPassable(_grid, x - 1, y - 1))
+        relaxNode(x - 1, y - 1, cost + diagonal_step_cost, _index);
+    if(is_right_free && is_top_free && isPassable(_grid, x + 1, y - 1))
+        relaxNode(x + 1, y - 1, cost + diagonal_step_cost, _index);
+    if(is_left_free && is_bottom_free && isPassable(_grid, x - 1, y + 1))
+        relaxNode(x - 1, y + 1, cost + diagonal_step_cost, _index);
+    if(is_right_free && is_bottom_free && isPassable(_grid, x + 1, y + 1))
+        relaxNode(x + 1, y + 1, cost + diagonal_step_cost, _index);
 }
 
-void AStar::emplaceSuccessors(const Node & _node)
+void AStar::relaxNode(int32_t _x, int32_t _y, float _cost, uint32_t _parent)
 {
-    emplaceNode(_node.index.matrix_index.x + 1, _node.index.matrix_index.y, _node);
-    emplaceNode(_node.index.matrix_index.x - 1, _node.index.matrix_index.y, _node);
-    emplaceNode(_node.index.matrix_index.x, _node.index.matrix_index.y + 1, _node);
-    emplaceNode(_node.index.matrix_index.x, _node.index.matrix_index.y - 1, _node);
-    if(mr_options.allow_diagonal_steps)
+    auto [index, is_inserted] = m_node_indices.tryEmplace(
+        OccupancyGrid::makeCellKey(_x, _y),
+        static_cast<uint32_t>(m_nodes.size()));
+    const CellPoint cell { .x = _x, .y = _y };
+    if(is_inserted)
     {
-        emplaceNode(_node.index.matrix_index.x - 1, _node.index.matrix_index.y - 1, _node);
-        emplaceNode(_node.index.matrix_index.x + 1, _node.index.matrix_index.y + 1, _node);
-        emplaceNode(_node.index.matrix_index.x - 1, _node.index.matrix_index.y + 1, _node);
-        emplaceNode(_node.index.matrix_index.x + 1, _node.index.matrix_index.y - 1, _node);
+        m_nodes.push_back(Node { .cell = cell, .cost = _cost, .parent = _parent, .is_closed = false });
     }
-}
-
-void AStar::emplaceNode(int32_t _x, int32_t _y, const Node & _parent_node)
-{
-    Index index { .matrix_index { _x, _y } };
-    if(m_known_nodes.contains(index.map_key))
-        return;
-    Node * node = new Node
+    else
     {
-        .x = _x,
-        .y = _y,
-        .cost = _parent_node.cost + s_step_cost,
-        .index = index,
-        .prev = &_parent_node
-    };
-    m_known_nodes.emplace(index.map_key, node);
-    float full_cost = node->cost +
-        getDistance(mr_dest_point, { m_start_point.x + _x * m_cell_size.x, m_start_point.y + _y * m_cell_size.y });
-    m_open_nodes.emplace(full_cost, node);
+        Node & node = m_nodes[*index];
+        if(node.is_closed || node.cost <= _cost)
+            return;
+        node.cost = _cost;
+        node.parent = _parent;
+    }
+    m_open_nodes.push_back(OpenNode {
+        .full_cost = _cost + estimate(cell, m_destination, m_allow_diagonal_steps),
+        .index = *index
+    });
+    std::push_heap(m_open_nodes.begin(), m_open_nodes.end());
 }
 
-inline float AStar::getDistance(const b2Vec2 & _p1, const b2Vec2 & _p2)
+float AStar::estimate(const CellPoint & _from, const CellPoint & _to, bool _allow_diagonal_steps)
 {
-    return std::sqrt(std::pow(_p2.x - _p1.x, 2) + std::pow(_p2.y - _p1.y, 2)); // TODO: can sqrt be removed?
+    const float dx = static_cast<float>(std::abs(_to.x - _from.x));
+    const float dy = static_cast<float>(std::abs(_to.y - _from.y));
+    if(!_allow_diagonal_steps)
+        return (dx + dy) * straight_step_cost;
+    // Octile distance
+    return (dx + dy) * straight_step_cost + (diagonal_step_cost - 2 * straight_step_cost) * std::min(dx, dy);
 }
 
-inline bool AStar::isDestination(const b2Vec2 & _point) const
+void AStar::collectCells(uint32_t _end_index, std::vector<CellPoint> & _cells) const
 {
-    return
-        std::abs(_point.x - mr_dest_point.x) <= m_cell_size.x / 2 &&
-        std::abs(_point.y - mr_dest_point.y) <= m_cell_size.y / 2;
+    const size_t offset = _cells.size();
+    for(uint32_t index = _end_index; index != s_no_parent; index = m_nodes[index].parent)
+        _cells.push_back(m_nodes[index].cell);
+    std::reverse(_cells.begin() + offset, _cells.end());
 }
 
-bool AStar::isDeadEnd(const b2Vec2 & _point) const
+std::vector<b2Vec2> AStar::makeWaypoints(
+    const OccupancyGrid & _grid,
+    const b2Vec2 & _start,
+    const std::vector<CellPoint> & _cells)
 {
-    float half_width = m_cell_size.x / 2; // TODO: to const
-    float half_height = m_cell_size.y / 2; // TODO: to const
-    b2AABB aabb
-    {
-        .lowerBound = b2Vec2(_point.x - half_width, _point.y - half_height),
-        .upperBound = b2Vec2(_point.x + half_width, _point.y + half_height)
-    };
-    struct OverlapResult
+    std::vector<b2Vec2> result;
+    result.push_back(_start);
+    for(size_t i = 1; i < _cells.size(); ++i)
     {
-        static bool callback(b2ShapeId __shapeId, void * __context)
+        // Skip the cells in the middle of straight and diagonal segments
+        if(i + 1 == _cells.size() ||
+            _cells[i].x - _cells[i - 1].x != _cells[i + 1].x - _cells[i].x ||
+            _cells[i].y - _cells[i - 1].y != _cells[i + 1].y - _cells[i].y)
         {
-            OverlapResult * self = static_cast<OverlapResult *>(__context);
-            b2BodyId body_id = b2Shape_GetBody(__shapeId);
-            if(B2_ID_EQUALS(body_id, self->astar->m_body_id) ||
-                (b2Shape_IsSensor(__shapeId) && !self->astar->mr_options.avoid_sensors))
-            {
-                return true;
-            }
-            self->is_dead_end = true;
-            return false;
+            result.push_back(_grid.getCellCenter(_cells[i].x, _cells[i].y));
         }
-
-        const AStar * astar;
-        bool is_dead_end;
-    };
-    OverlapResult result { .astar = this, .is_dead_end = false };
-    b2World_OverlapAABB( // FIXME: Invalid when the world is locked
-        m_world_id,
-        aabb,
-        b2QueryFilter { .categoryBits = B2_DEFAULT_CATEGORY_BITS, .maskBits = B2_DEFAULT_MASK_BITS },
-        &OverlapResult::callback,
-        &result);
-    return result.is_dead_end;
-}
-
-std::vector<b2Vec2> AStar::translatePath(const Node & _end_node) const
-{
-    std::stack<std::pair<int32_t, int32_t>> node_points;
-    node_points.push(std::make_pair(_end_node.x, _end_node.y));
-    for(const Node * node = _end_node.prev; node != nullptr; node = node->prev)
-    {
-        const std::pair<int32_t, int32_t> & next = node_points.top();
-        const Node * prev = node->prev;
-        if(!prev || !arePointsInRow(prev->x, prev->y, node->x, node->y, next.first, next.second))
-            node_points.push(std::make_pair(node->x, node->y));
-    }
-    std::vector<b2Vec2> result;
-    result.reserve(node_points.size());
-    while(!node_points.empty())
-    {
-        const std::pair<int32_t, int32_t> & point = node_points.top();
-        result.push_back(b2Vec2(m_start_point.x + point.first * m_cell_size.x, m_start_point.y + point.second * m_cell_size.y));
-        node_points.pop();
     }
     return result;
 }
-
-inline bool AStar::arePointsInRow(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3)
-{
-    return (x1 == x2 && x1 == x3) || (y1 == y2 && y1 == y3); // TODO: diagonal
-}
-
-std::optional<std::vector<b2Vec2>> Sol2D::World::aStarFindPath(
-    b2WorldId _world,
-    b2BodyId _body_id,
-    const b2Vec2 & _destination,
-    const AStarOptions & _options)
-{
-    AStar a(_world, _body_id, _destination, _options);
-    return a.exec();
-}
@@ -16,7 +16,8 @@
 
 #pragma once
 
-#include <box2d/box2d.h>
+#include <Sol2D/World/OccupancyGrid.h>
+#include <numbers>
 #include <vector>
 #include <optional>
 
@@ -24,20 +25,103 @@ namespace Sol2D::World {
 
 struct AStarOptions
 {
+    static constexpr uint32_t default_max_expansions = 10000;
+
     AStarOptions() :
         allow_diagonal_steps(false),
-        avoid_sensors(false)
+        avoid_sensors(false),
+        allow_partial_path(false),
+        is_hierarchical(false),
+        max_expansions(default_max_expansions)
     {
     }
 
     bool allow_diagonal_steps;
     bool avoid_sensors;
+    bool allow_partial_path;
+    bool is_hierarchical;
+    uint32_t max_expansions; // Must be positive, the grid is unbounded
 };
 
-std::optional<std::vector<b2Vec2>> aStarFindPath(
-    b2WorldId _world_id,
-    b2BodyId _body_id,
-    const b2Vec2 & _destination,
-    const AStarOptions & _options);
+struct AStarResult
+{
+    std::vector<b2Vec2> points;
+    bool is_complete;
+};
+
+// The search buffers are kept between the calls to avoid allocations.
+class AStar final
+{
+    S2_DISABLE_COPY_AND_MOVE(AStar)
+
+public:
+    static constexpr float straight_step_cost = 1.0f;
+    static constexpr float diagonal_step_cost = std::numbers::sqrt2_v<float>;
+
+    AStar() = default;
+    std::optional<AStarResult> findPath(
+        OccupancyGrid & _grid,
+        const b2Vec2 & _start,
+        const b2Vec2 & _destination,
+        const AStarOptions & _options);
+    bool findCellPath(
+        OccupancyGrid & _grid,
+        const CellPoint & _from,
+        const CellPoint & _to,
+        const CellRect & _bounds,
+        bool _allow_diagonal_steps,
+        std::vector<CellPoint> & _path);
+    static float estimate(const CellPoint & _from, const CellPoint & _to, bool _allow_diagonal_steps);
+    static std::vector<b2Vec2> makeWaypoints(
+        const OccupancyGrid & _grid,
+        const b2Vec2 & _start,
+        const std::vector<CellPoint> & _cells);
+
+private:
+    struct Node
+    {
+        CellPoint cell;
+        float cost;
+        uint32_t parent;
+        bool is_closed;
+    };
+
+    struct OpenNode
+    {
+        float full_cost;
+        uint32_t index;
+
+        bool operator < (const OpenNode & _other) const
+        {
+            return full_cost > _other.full_cost;
+        }
+    };
+
+    bool search(
+        OccupancyGrid & _grid,
+        const CellPoint & _from,
+        const CellPoint & _to,
+        uint32_t _max_expansions,
+        uint32_t & _end_index);
+    bool isPassable(OccupancyGrid & _grid, int32_t _x, int32_t _y) const;
+    void expandNode(uint32_t _index, OccupancyGrid & _grid);
+    void relaxNode(int32_t _x, int32_t _y, float _cost, uint32_t _parent);
+    void collectCells(uint32_t _end_index, std::vector<CellPoint> & _cells) const;
+
+private:
+    static constexpr uint32_t s_no_parent = static_cast<uint32_t>(-1);
+    CellPoint m_destination = { .x = 0, .y = 0 };
+    bool m_allow_diagonal_steps = false;
+    const CellRect * mp_bounds = nullptr;
+    std::vector<Node> m_nodes;
+    CellTable<uint32_t> m_node_indices;
+    std::vector<OpenNode> m_open_nodes;
+    std::vector<CellPoint> m_cells;
+};
+
+inline bool AStar::isPassable(OccupancyGrid & _grid, int32_t _x, int32_t _y) const
+{
+    return (!mp_bounds || mp_bounds->contains(CellPoint { .x = _x, .y = _y })) && !_grid.isBlocked(_x, _y);
+}
 
 } // namespace Sol2D::World
@@ -17,58 +17,110 @@
 #pragma once
 
 #include <Sol2D/Def.h>
-#include <boost/container/slist.hpp>
-#include <functional>
+#include <box2d/box2d.h>
+#include <boost/container/flat_map.hpp>
+#include <vector>
 
 namespace Sol2D::World {
 
+enum class ActionType : uint8_t
+{
+    SetGravity,
+    SetBodyPosition,
+    ApplyForceToCenter,
+    ApplyImpulseToCenter
+};
+
+struct Action
+{
+    ActionType type;
+    uint64_t body_id;
+    b2Vec2 vector;
+};
+
+// Actions are executed in the order of submission. Repeated actions are coalesced in the place of the first one:
+// the last position and gravity win, forces and impulses are summed up.
+// Destroyed bodies are collected separately to be destroyed together before the other actions are executed.
+// The buffers keep their capacity, so no memory is allocated once the queue is warmed up.
 class ActionQueue final
 {
     S2_DISABLE_COPY_AND_MOVE(ActionQueue)
 
 public:
-    ActionQueue(boost::container::slist<std::function<void()>> & _actions) :
-        mr_actions(_actions)
+    ActionQueue() = default;
+
+    void setGravity(const b2Vec2 & _gravity)
     {
+        enqueue(ActionType::SetGravity, 0, _gravity, false);
     }
 
-    void enqueueAction(std::function<void()> _action)
+    void setBodyPosition(uint64_t _body_id, const b2Vec2 & _position)
     {
-        mr_actions.push_front(_action);
+        enqueue(ActionType::SetBodyPosition, _body_id, _position, false);
     }
 
-private:
-    boost::container::slist<std::function<void()>> & mr_actions;
-};
+    void applyForceToCenter(uint64_t _body_id, const b2Vec2 & _force)
+    {
+        enqueue(ActionType::ApplyForceToCenter, _body_id, _force, true);
+    }
 
-class ActionAccumulator final
-{
-    S2_DISABLE_COPY_AND_MOVE(ActionAccumulator)
+    void applyImpulseToCenter(uint64_t _body_id, const b2Vec2 & _impulse)
+    {
+        enqueue(ActionType::ApplyImpulseToCenter, _body_id, _impulse, true);
+    }
 
-public:
-    ActionAccumulator() :
-        m_queue(m_actions)
+    void destroyBody(uint64_t _body_id)
     {
+        m_destroyed_body_ids.push_back(_body_id);
     }
 
-    void executeActions()
+    bool isEmpty() const
     {
-        if(!m_actions.empty())
-        {
-            for(auto & action : m_actions)
-                action();
-        }
-        m_actions.clear();
+        return m_actions.empty() && m_destroyed_body_ids.empty();
     }
 
-    ActionQueue & getQueue()
+    template<typename DestroyBody, typename Execute>
+    void execute(DestroyBody _destroy_body, Execute _execute);
+
+    void clear()
     {
-        return m_queue;
+        m_actions.clear();
+        m_action_indices.clear();
+        m_destroyed_body_ids.clear();
     }
 
 private:
-    boost::container::slist<std::function<void()>> m_actions;
-    ActionQueue m_queue;
+    void enqueue(ActionType _type, uint64_t _body_id, const b2Vec2 & _vector, bool _accumulate);
+
+private:
+    std::vector<Action> m_actions;
+    boost::container::flat_map<std::pair<ActionType, uint64_t>, size_t> m_action_indices;
+    std::vector<uint64_t> m_destroyed_body_ids;
 };
 
+inline void ActionQueue::enqueue(ActionType _type, uint64_t _body_id, const b2Vec2 & _vector, bool _accumulate)
+{
+    auto result = m_action_indices.try_emplace(std::make_pair(_type, _body_id), m_actions.size());
+    if(result.second)
+    {
+        m_actions.push_back({ .type = _type, .body_id = _body_id, .vector = _vector });
+        return;
+    }
+    Action & action = m_actions[result.first->second];
+    if(_accumulate)
+        action.vector = b2Add(action.vector, _vector);
+    else
+        action.vector = _vector;
+}
+
+template<typename DestroyBody, typename Execute>
+void ActionQueue::execute(DestroyBody _destroy_body, Execute _execute)
+{
+    for(uint64_t body_id : m_destroyed_body_ids)
+        _destroy_body(body_id);
+    for(const Action & action : m_actions)
+        _execute(action);
+    clear();
+}
+
 } // namespace Sol2D::World
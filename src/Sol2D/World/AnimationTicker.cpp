@@ -0,0 +1,142 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <Sol2D/World/AnimationTicker.h>
+
+using namespace Sol2D;
+using namespace Sol2D::World;
+
+void AnimationTicker::attach(uint64_t _body_id, BodyShape & _shape)
+{
+    GraphicsPack * pack = _shape.getCurrentGraphics();
+    if(!pack)
+    {
+        detach(_shape);
+        return;
+    }
+    size_t index;
+    auto it = m_indices.find(&_shape);
+    if(it == m_indices.end())
+    {
+        index = m_shapes.size();
+        m_elapsed.push_back(0);
+        m_time_left.push_back(0);
+        m_shapes.push_back(&_shape);
+        m_body_ids.push_back(_body_id);
+        m_indices.insert(std::make_pair(&_shape, index));
+    }
+    else
+    {
+        index = it->second;
+    }
+    m_elapsed[index] = 0;
+    m_time_left[index] = pack->getFrameTimeLeft().count();
+}
+
+void AnimationTicker::detach(const BodyShape & _shape)
+{
+    auto it = m_indices.find(&_shape);
+    if(it != m_indices.end())
+        remove(it->second);
+}
+
+void AnimationTicker::remove(size_t _index)
+{
+    const size_t last = m_shapes.size() - 1;
+    m_indices.erase(m_shapes[_index]);
+    if(_index != last)
+    {
+        m_elapsed[_index] = m_elapsed[last];
+        m_time_left[_index] = m_time_left[last];
+        m_shapes[_index] = m_shapes[last];
+        m_body_ids[_index] = m_body_ids[last];
+        m_indices[m_shapes[_index]] = _index;
+    }
+    m_elapsed.pop_back();
+    m_time_left.pop_back();
+    m_shapes.pop_back();
+    m_body_ids.pop_back();
+}
+
+void AnimationTicker::sync(const BodyShape & _shape)
+{
+    auto it = m_indices.find(&_shape);
+    if(it == m_indices.end())
+        return;
+    const size_t index = it->second;
+    if(m_elapsed[index] > 0)
+        advance(index);
+    // The pack can be changed by the caller, so the time left is recalculated on the next tick
+    m_time_left[index] = -1;
+}
+
+void AnimationTicker::clear()
+{
+    m_elapsed.clear();
+    m_time_left.clear();
+    m_shapes.clear();
+    m_body_ids.clear();
+    m_indices.clear();
+    m_events.clear();
+}
+
+void AnimationTicker::tick(std::chrono::milliseconds _delta_time)
+{
+    const int64_t delta = _delta_time.count();
+    const size_t count = m_elapsed.size();
+    for(size_t i = 0; i < count; ++i)
+    {
+        m_elapsed[i] += delta;
+        if(m_elapsed[i] > m_time_left[i])
+            advance(i);
+    }
+}
+
+void AnimationTicker::advance(size_t _index)
+{
+    GraphicsPack * pack = m_shapes[_index]->getCurrentGraphics();
+    if(!pack)
+    {
+        m_elapsed[_index] = 0;
+        m_time_left[_index] = std::chrono::milliseconds::max().count();
+        return;
+    }
+    const size_t frame_index = pack->getCurrentFrameIndex();
+    const size_t iteration = pack->getCurrentAnimationIteration();
+    pack->advance(std::chrono::milliseconds(m_elapsed[_index]));
+    m_elapsed[_index] = 0;
+    m_time_left[_index] = pack->getFrameTimeLeft().count();
+    if(pack->getCurrentAnimationIteration() != iteration)
+    {
+        m_events.push_back(AnimationEvent
+        {
+            .type = AnimationEvent::Type::LoopEnded,
+            .body_id = m_body_ids[_index],
+            .shape_key = m_shapes[_index]->getKey(),
+            .frame_index = pack->getCurrentFrameIndex()
+        });
+    }
+    if(pack->getCurrentFrameIndex() != frame_index)
+    {
+        m_events.push_back(AnimationEvent
+        {
+            .type = AnimationEvent::Type::FrameChanged,
+            .body_id = m_body_ids[_index],
+            .shape_key = m_shapes[_index]->getKey(),
+            .frame_index = pack->getCurrentFrameIndex()
+        });
+    }
+}
@@ -0,0 +1,83 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <Sol2D/World/BodyShape.h>
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+namespace Sol2D::World {
+
+struct AnimationEvent
+{
+    enum class Type
+    {
+        FrameChanged,
+        LoopEnded
+    };
+
+    Type type;
+    uint64_t body_id;
+    std::string shape_key;
+    size_t frame_index;
+};
+
+class AnimationObserver
+{
+public:
+    virtual ~AnimationObserver() { }
+    virtual void onAnimationFrameChanged(const AnimationEvent & _event) = 0;
+    virtual void onAnimationLoopEnded(const AnimationEvent & _event) = 0;
+};
+
+class AnimationTicker final
+{
+    S2_DISABLE_COPY_AND_MOVE(AnimationTicker)
+
+public:
+    AnimationTicker() = default;
+    void attach(uint64_t _body_id, BodyShape & _shape);
+    void detach(const BodyShape & _shape);
+    void sync(const BodyShape & _shape);
+    void clear();
+    void tick(std::chrono::milliseconds _delta_time);
+    std::vector<AnimationEvent> takeEvents();
+
+private:
+    void advance(size_t _index);
+    void remove(size_t _index);
+
+private:
+    // Hot data, touched for every animation on every step
+    std::vector<int64_t> m_elapsed;
+    std::vector<int64_t> m_time_left;
+    // Cold data, touched only when a frame ends
+    std::vector<BodyShape *> m_shapes;
+    std::vector<uint64_t> m_body_ids;
+    std::unordered_map<const BodyShape *, size_t> m_indices;
+    std::vector<AnimationEvent> m_events;
+};
+
+inline std::vector<AnimationEvent> AnimationTicker::takeEvents()
+{
+    std::vector<AnimationEvent> events;
+    events.swap(m_events);
+    return events;
+}
+
+} // namespace Sol2D::World
@@ -0,0 +1,119 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <Sol2D/World/AsyncPathFinder.h>
+#include <algorithm>
+
+using namespace Sol2D::World;
+
+AsyncPathFinder::AsyncPathFinder(uint32_t _worker_count) :
+    m_is_stopping(false)
+{
+    _worker_count = std::max<uint32_t>(_worker_count, 1);
+    m_workers.reserve(_worker_count);
+    m_threads.reserve(_worker_count);
+    for(uint32_t i = 0; i < _worker_count; ++i)
+    {
+        m_workers.push_back(std::make_unique<Worker>());
+        m_threads.emplace_back(&AsyncPathFinder::work, this, std::ref(*m_workers.back()));
+    }
+}
+
+AsyncPathFinder::~AsyncPathFinder()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_is_stopping = true;
+        m_requests.clear();
+    }
+    m_condition.notify_all();
+    for(std::thread & thread : m_threads)
+        thread.join();
+}
+
+void AsyncPathFinder::enqueue(PathRequest && _request)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_requests.push_back(std::move(_request));
+    }
+    m_condition.notify_one();
+}
+
+// A request that is already being processed cannot be cancelled, its response must be ignored
+bool AsyncPathFinder::cancel(uint64_t _request_id)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = std::find_if(m_requests.begin(), m_requests.end(), [_request_id](const PathRequest & __request) {
+        return __request.id == _request_id;
+    });
+    if(it == m_requests.end())
+        return false;
+    m_requests.erase(it);
+    return true;
+}
+
+bool AsyncPathFinder::tryTakeResponse(PathResponse & _response)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(m_responses.empty())
+        return false;
+    _response = std::move(m_responses.front());
+    m_responses.pop_front();
+    return true;
+}
+
+void AsyncPathFinder::work(Worker & _worker)
+{
+    for(;;)
+    {
+        PathRequest request;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_is_stopping || !m_requests.empty(); });
+            if(m_is_stopping)
+                return;
+            request = std::move(m_requests.front());
+            m_requests.pop_front();
+        }
+        PathResponse response { .id = request.id, .result = process(_worker, request) };
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_responses.push_back(std::move(response));
+    }
+}
+
+std::optional<AStarResult> AsyncPathFinder::process(Worker & _worker, const PathRequest & _request)
+{
+    // The grid and the clusters are reused until the snapshot changes
+    if(_worker.snapshot != _request.snapshot)
+    {
+        _worker.snapshot = _request.snapshot;
+        _worker.cluster_graphs[0].reset();
+        _worker.cluster_graphs[1].reset();
+        _worker.grid = std::make_unique<OccupancyGrid>(_request.snapshot);
+    }
+    if(!_request.options.is_hierarchical)
+        return _worker.astar.findPath(*_worker.grid, _request.start, _request.destination, _request.options);
+    std::unique_ptr<ClusterGraph> & graph = _worker.cluster_graphs[_request.options.allow_diagonal_steps ? 1 : 0];
+    if(!graph)
+        graph = std::make_unique<ClusterGraph>(*_worker.grid, _request.options.allow_diagonal_steps);
+    return _worker.hierarchical_astar.findPath(
+        *graph,
+        _worker.astar,
+        _request.start,
+        _request.destination,
+        _request.options);
+}
@@ -0,0 +1,79 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <Sol2D/World/AStar.h>
+#include <Sol2D/World/HierarchicalAStar.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace Sol2D::World {
+
+struct PathRequest
+{
+    uint64_t id;
+    b2Vec2 start;
+    b2Vec2 destination;
+    AStarOptions options;
+    std::shared_ptr<const OccupancySnapshot> snapshot;
+};
+
+struct PathResponse
+{
+    uint64_t id;
+    std::optional<AStarResult> result;
+};
+
+// Searches paths on the worker threads, the workers see only the immutable occupancy snapshots.
+class AsyncPathFinder final
+{
+    S2_DISABLE_COPY_AND_MOVE(AsyncPathFinder)
+
+private:
+    struct Worker
+    {
+        std::shared_ptr<const OccupancySnapshot> snapshot;
+        std::unique_ptr<OccupancyGrid> grid;
+        std::unique_ptr<ClusterGraph> cluster_graphs[2]; // By diagonal steps permission
+        AStar astar;
+        HierarchicalAStar hierarchical_astar;
+    };
+
+public:
+    explicit AsyncPathFinder(uint32_t _worker_count);
+    ~AsyncPathFinder();
+    void enqueue(PathRequest && _request);
+    bool cancel(uint64_t _request_id);
+    bool tryTakeResponse(PathResponse & _response);
+
+private:
+    void work(Worker & _worker);
+    static std::optional<AStarResult> process(Worker & _worker, const PathRequest & _request);
+
+private:
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<PathRequest> m_requests;
+    std::deque<PathResponse> m_responses;
+    bool m_is_stopping;
+};
+
+} // namespace Sol2D::World
@@ -19,7 +19,7 @@
 #include <Sol2D/World/BodyShape.h>
 #include <Sol2D/World/ActionQueue.h>
 #include <Sol2D/Utils/PreHashedMap.h>
-#include <Sol2D/Utils/SequentialId.h>
+#include <Sol2D/Utils/SlotMap.h>
 #include <optional>
 
 namespace Sol2D::World {
@@ -29,17 +29,25 @@ class Body final
     S2_DISABLE_COPY_AND_MOVE(Body)
 
 public:
-    explicit Body(b2BodyId _b2_body_id, ActionQueue & _action_queue) :
-        m_gid(s_sequential_id.getNext()),
+    Body(
+        uint64_t _gid,
+        b2BodyId _b2_body_id,
+        ActionQueue & _action_queue,
+        Utils::SlotMap<BodyShape> & _shape_pool
+    ) :
+        m_gid(_gid),
         m_b2_body_id(_b2_body_id),
-        mr_action_queue(_action_queue)
+        mr_action_queue(_action_queue),
+        mr_shape_pool(_shape_pool),
+        m_layer_index(0),
+        m_is_destruction_pending(false)
     {
     }
 
     ~Body()
     {
         for(const auto & shape : m_shapes)
-            delete shape.second;
+            mr_shape_pool.erase(shape.second->getGid());
     }
 
     uint64_t getGid() const
@@ -47,12 +55,9 @@ public:
         return m_gid;
     }
 
-    void setPosition(const SDL_FPoint & _position)
+    b2BodyId getBox2dId() const
     {
-        mr_action_queue.enqueueAction([this, _position]() {
-            if(B2_IS_NON_NULL(m_b2_body_id))
-                b2Body_SetTransform(m_b2_body_id, toBox2D(_position), b2Body_GetRotation(m_b2_body_id));
-        });
+        return m_b2_body_id;
     }
 
     std::optional<SDL_FPoint> getPosition() const
@@ -84,25 +89,19 @@ public:
 
     void applyForceToCenter(const SDL_FPoint & _force)
     {
-        mr_action_queue.enqueueAction([this, _force]() {
-            if(B2_IS_NON_NULL(m_b2_body_id))
-                b2Body_ApplyForceToCenter(m_b2_body_id, toBox2D(_force), true); // TODO: what is wake?
-        });
+        mr_action_queue.applyForceToCenter(m_gid, toBox2D(_force));
     }
 
     void applyImpulseToCenter(const SDL_FPoint & _impulse)
     {
-        mr_action_queue.enqueueAction([this, _impulse]() {
-            if(B2_IS_NON_NULL(m_b2_body_id))
-                b2Body_ApplyLinearImpulseToCenter(m_b2_body_id, toBox2D(_impulse), true); // TODO: what is wake?
-        });
+        mr_action_queue.applyImpulseToCenter(m_gid, toBox2D(_impulse));
     }
 
     BodyShape & createShape(const std::string & _key, std::optional<uint32_t> _tile_map_object_id = std::nullopt)
     {
-        BodyShape * shape = new BodyShape(_key, _tile_map_object_id);
-        m_shapes.insert(std::make_pair(_key, shape));
-        return *shape;
+        BodyShape & shape = mr_shape_pool.emplace(_key, _tile_map_object_id);
+        m_shapes.insert(std::make_pair(_key, &shape));
+        return shape;
     }
 
     BodyShape * findShape(const Utils::PreHashedKey<std::string> & _key)
@@ -111,6 +110,13 @@ public:
         return it == m_shapes.end() ? nullptr : it->second;
     }
 
+    template<typename Callback>
+    void forEachShape(Callback _callback)
+    {
+        for(auto & pair : m_shapes)
+            _callback(*pair.second);
+    }
+
     void setLayer(const std::optional<std::string> & _layer)
     {
         m_layer = _layer;
@@ -121,13 +127,36 @@ public:
         return m_layer;
     }
 
+    // The index of the body in the body list of its layer
+    void setLayerIndex(size_t _index)
+    {
+        m_layer_index = _index;
+    }
+
+    size_t getLayerIndex() const
+    {
+        return m_layer_index;
+    }
+
+    void markForDestruction()
+    {
+        m_is_destruction_pending = true;
+    }
+
+    bool isDestructionPending() const
+    {
+        return m_is_destruction_pending;
+    }
+
 private:
-    static Utils::SequentialId<uint64_t> s_sequential_id;
-    uint64_t m_gid;
+    const uint64_t m_gid;
     b2BodyId m_b2_body_id;
     ActionQueue & mr_action_queue;
+    Utils::SlotMap<BodyShape> & mr_shape_pool;
     Utils::PreHashedMap<std::string, BodyShape *> m_shapes;
     std::optional<std::string> m_layer;
+    size_t m_layer_index;
+    bool m_is_destruction_pending;
 };
 
 } // namespace Sol2D::World
@@ -26,7 +26,10 @@ namespace Sol2D::World {
 struct BodyOptions
 {
     BodyOptions() :
-        type(BodyType::Static)
+        type(BodyType::Static),
+        is_merged(false),
+        use_chain_outlines(false),
+        merge_rectangles(false)
     {
     }
 
@@ -34,6 +37,9 @@ struct BodyOptions
     std::optional<std::string> shape_key;
     BodyPhysicsDefinition body_physics;
     BodyShapePhysicsDefinition shape_physics;
+    bool is_merged; // Static objects of each object layer are merged into a single body
+    bool use_chain_outlines; // Polygons become chain loops
+    bool merge_rectangles; // Adjacent rectangles of merged bodies are merged
 };
 
 } // namespace Sol2D::World
@@ -0,0 +1,82 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <Sol2D/World/BodyType.h>
+#include <Sol2D/GraphicsPack.h>
+#include <Sol2D/Utils/PreHashedMap.h>
+#include <box2d/box2d.h>
+#include <optional>
+#include <variant>
+#include <vector>
+
+namespace Sol2D::World {
+
+struct BodyPrototypeShape
+{
+    using Geometry = std::variant<b2Polygon, b2Circle, b2Capsule>;
+
+    std::string key;
+    std::optional<std::string> tag;
+    uint32_t tag_id;
+    bool is_pre_solve_enabled;
+    b2ShapeDef b2_shape_def;
+    Geometry geometry;
+    std::vector<std::pair<Utils::PreHashedKey<std::string>, GraphicsPack>> graphics;
+};
+
+struct BodyPrototypeOverrides
+{
+    std::optional<BodyType> type;
+    std::optional<std::string> layer;
+    std::optional<SDL_FPoint> linear_velocity;
+};
+
+class BodyPrototype final
+{
+    S2_DISABLE_COPY_AND_MOVE(BodyPrototype)
+
+public:
+    BodyPrototype(uint64_t _gid, const b2BodyDef & _b2_body_def, std::vector<BodyPrototypeShape> && _shapes) :
+        m_gid(_gid),
+        m_b2_body_def(_b2_body_def),
+        m_shapes(std::move(_shapes))
+    {
+    }
+
+    uint64_t getGid() const
+    {
+        return m_gid;
+    }
+
+    const b2BodyDef & getBox2dBodyDef() const
+    {
+        return m_b2_body_def;
+    }
+
+    const std::vector<BodyPrototypeShape> & getShapes() const
+    {
+        return m_shapes;
+    }
+
+private:
+    const uint64_t m_gid;
+    const b2BodyDef m_b2_body_def;
+    const std::vector<BodyPrototypeShape> m_shapes;
+};
+
+} // namespace Sol2D::World
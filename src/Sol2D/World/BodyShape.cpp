@@ -20,9 +20,12 @@ using namespace Sol2D;
 using namespace Sol2D::World;
 using namespace Sol2D::Utils;
 
-BodyShape::BodyShape(const std::string & _key, std::optional<uint32_t> _tile_map_object_id) :
+BodyShape::BodyShape(uint64_t _gid, const std::string & _key, std::optional<uint32_t> _tile_map_object_id) :
+    m_gid(_gid),
     m_key(_key),
     m_tile_map_object_id(_tile_map_object_id),
+    m_tag_id(0),
+    m_is_pre_solve_enabled(false),
     mp_current_graphics(nullptr)
 {
 }
@@ -54,6 +57,14 @@ void BodyShape::addGraphics(
     m_graphics[_key] = new GraphicsPack(_renderer, _definition);
 }
 
+void BodyShape::addGraphics(const PreHashedKey<std::string> & _key, const GraphicsPack & _graphics)
+{
+    auto it = m_graphics.find(_key);
+    if(it != m_graphics.end())
+        delete it->second;
+    m_graphics[_key] = new GraphicsPack(_graphics);
+}
+
 bool BodyShape::setCurrentGraphics(const PreHashedKey<std::string> & _key)
 {
     GraphicsPack * graphics = getGraphics(_key);
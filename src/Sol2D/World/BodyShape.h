@@ -26,14 +26,21 @@ class BodyShape final
     S2_DISABLE_COPY_AND_MOVE(BodyShape)
 
 public:
-    BodyShape(const std::string & _key, std::optional<uint32_t> _tile_map_object_id);
+    BodyShape(uint64_t _gid, const std::string & _key, std::optional<uint32_t> _tile_map_object_id);
     ~BodyShape();
+    uint64_t getGid() const;
     const std::string & getKey() const;
     const std::optional<uint32_t> getTileMapObjectId() const;
+    const std::optional<std::string> & getTag() const;
+    uint32_t getTagId() const;
+    void setTag(const std::optional<std::string> & _tag, uint32_t _tag_id);
+    bool isPreSolveEnabled() const;
+    void setPreSolveEnabled(bool _is_enabled);
     void addGraphics(
         Renderer & _renderer,
         const Utils::PreHashedKey<std::string> & _key,
         const GraphicsPackDefinition & _definition);
+    void addGraphics(const Utils::PreHashedKey<std::string> & _key, const GraphicsPack & _graphics);
     bool setCurrentGraphics(const Utils::PreHashedKey<std::string> & _key);
     GraphicsPack * getCurrentGraphics();
     std::optional<Utils::PreHashedKey<std::string>> getCurrentGraphicsKey() const;
@@ -41,13 +48,48 @@ public:
     bool flipGraphics(const Utils::PreHashedKey<std::string> & _key, bool _flip_horizontally, bool _flip_vertically);
 
 private:
+    const uint64_t m_gid;
     const std::string m_key;
     const std::optional<uint32_t> m_tile_map_object_id;
+    std::optional<std::string> m_tag;
+    uint32_t m_tag_id;
+    bool m_is_pre_solve_enabled;
     Utils::PreHashedMap<std::string, GraphicsPack *> m_graphics;
     GraphicsPack * mp_current_graphics;
     std::optional<Utils::PreHashedKey<std::string>> m_current_graphics_key;
 };
 
+inline uint64_t BodyShape::getGid() const
+{
+    return m_gid;
+}
+
+inline const std::optional<std::string> & BodyShape::getTag() const
+{
+    return m_tag;
+}
+
+inline uint32_t BodyShape::getTagId() const
+{
+    return m_tag_id;
+}
+
+inline void BodyShape::setTag(const std::optional<std::string> & _tag, uint32_t _tag_id)
+{
+    m_tag = _tag;
+    m_tag_id = _tag_id;
+}
+
+inline bool BodyShape::isPreSolveEnabled() const
+{
+    return m_is_pre_solve_enabled;
+}
+
+inline void BodyShape::setPreSolveEnabled(bool _is_enabled)
+{
+    m_is_pre_solve_enabled = _is_enabled;
+}
+
 inline GraphicsPack * BodyShape::getCurrentGraphics()
 {
     return mp_current_graphics;
@@ -17,9 +17,18 @@
 #pragma once
 
 #include <optional>
+#include <string>
+#include <vector>
 
 namespace Sol2D::World {
 
+struct CollisionFilterDefinition
+{
+    std::vector<std::string> categories;
+    std::optional<std::vector<std::string>> mask;
+    std::optional<int32_t> group;
+};
+
 struct BodyShapePhysicsDefinition
 {
     BodyShapePhysicsDefinition() :
@@ -31,6 +40,8 @@ struct BodyShapePhysicsDefinition
     std::optional<float> density;
     std::optional<float> restitution;
     std::optional<float> friction;
+    std::optional<std::string> tag;
+    CollisionFilterDefinition collision_filter;
     bool is_sensor;
     bool is_pre_solve_enabled;
 };
@@ -0,0 +1,182 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <Sol2D/World/Box2dTaskSystem.h>
+#include <algorithm>
+
+using namespace Sol2D::World;
+
+// The calling thread (the one that steps the world) is the worker 0, it executes jobs while waiting for a task.
+// Other workers are the threads of the system.
+Box2dTaskSystem::Box2dTaskSystem(uint32_t _worker_count) :
+    m_worker_count(std::clamp<uint32_t>(_worker_count, 1, max_worker_count)),
+    m_is_stopping(false),
+    m_is_serial(false)
+{
+    m_threads.reserve(m_worker_count - 1);
+    for(uint32_t i = 1; i < m_worker_count; ++i)
+        m_threads.emplace_back(&Box2dTaskSystem::work, this, i);
+}
+
+Box2dTaskSystem::~Box2dTaskSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_is_stopping = true;
+    }
+    m_condition.notify_all();
+    for(std::thread & thread : m_threads)
+        thread.join();
+}
+
+void Box2dTaskSystem::setup(b2WorldDef & _world_def)
+{
+    if(m_worker_count < 2)
+        return;
+    _world_def.workerCount = static_cast<int>(m_worker_count);
+    _world_def.enqueueTask = &Box2dTaskSystem::enqueueTask;
+    _world_def.finishTask = &Box2dTaskSystem::finishTask;
+    _world_def.userTaskContext = this;
+}
+
+// Runs the callback outside of a world step, the calling thread takes part in the execution
+void Box2dTaskSystem::execute(b2TaskCallback * _callback, int32_t _item_count, int32_t _min_range, void * _context)
+{
+    if(m_worker_count < 2)
+    {
+        if(_item_count > 0)
+            _callback(0, _item_count, 0, _context);
+        return;
+    }
+    if(void * task = enqueueTask(_callback, _item_count, _min_range, _context, this))
+        finishTask(task, this);
+}
+
+void * Box2dTaskSystem::enqueueTask(
+    b2TaskCallback * _callback,
+    int32_t _item_count,
+    int32_t _min_range,
+    void * _task_context,
+    void * _user_context)
+{
+    Box2dTaskSystem * self = static_cast<Box2dTaskSystem *>(_user_context);
+    if(_item_count <= 0)
+        return nullptr;
+    if(self->m_is_serial)
+    {
+        // Box2D does not wait for a null task, it is considered to be executed in place
+        _callback(0, _item_count, 0, _task_context);
+        return nullptr;
+    }
+    if(_min_range < 1)
+        _min_range = 1;
+    const int32_t job_count = std::min<int32_t>(
+        static_cast<int32_t>(self->m_worker_count),
+        (_item_count + _min_range - 1) / _min_range);
+    const int32_t items_per_job = _item_count / job_count;
+    const int32_t remainder = _item_count % job_count;
+    Task * task = self->acquireTask();
+    task->pending_job_count.store(job_count, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(self->m_mutex);
+        int32_t start = 0;
+        for(int32_t i = 0; i < job_count; ++i)
+        {
+            const int32_t end = start + items_per_job + (i < remainder ? 1 : 0);
+            self->m_jobs.push_back({
+                .callback = _callback,
+                .start = start,
+                .end = end,
+                .context = _task_context,
+                .task = task
+            });
+            start = end;
+        }
+    }
+    if(job_count == 1)
+        self->m_condition.notify_one();
+    else
+        self->m_condition.notify_all();
+    return task;
+}
+
+void Box2dTaskSystem::finishTask(void * _user_task, void * _user_context)
+{
+    Box2dTaskSystem * self = static_cast<Box2dTaskSystem *>(_user_context);
+    Task * task = static_cast<Task *>(_user_task);
+    while(task->pending_job_count.load(std::memory_order_acquire) > 0)
+    {
+        if(!self->tryExecuteJob(0))
+            std::this_thread::yield();
+    }
+    self->releaseTask(task);
+}
+
+void Box2dTaskSystem::work(uint32_t _worker_index)
+{
+    for(;;)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_is_stopping || !m_jobs.empty(); });
+            if(m_jobs.empty())
+                return;
+            job = m_jobs.front();
+            m_jobs.pop_front();
+        }
+        executeJob(job, _worker_index);
+    }
+}
+
+bool Box2dTaskSystem::tryExecuteJob(uint32_t _worker_index)
+{
+    Job job;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(m_jobs.empty())
+            return false;
+        job = m_jobs.front();
+        m_jobs.pop_front();
+    }
+    executeJob(job, _worker_index);
+    return true;
+}
+
+void Box2dTaskSystem::executeJob(const Job & _job, uint32_t _worker_index)
+{
+    _job.callback(_job.start, _job.end, _worker_index, _job.context);
+    _job.task->pending_job_count.fetch_sub(1, std::memory_order_release);
+}
+
+Box2dTaskSystem::Task * Box2dTaskSystem::acquireTask()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(m_free_tasks.empty())
+    {
+        m_tasks.push_back(std::make_unique<Task>());
+        return m_tasks.back().get();
+    }
+    Task * task = m_free_tasks.back();
+    m_free_tasks.pop_back();
+    return task;
+}
+
+void Box2dTaskSystem::releaseTask(Task * _task)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_free_tasks.push_back(_task);
+}
@@ -0,0 +1,98 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <Sol2D/Def.h>
+#include <box2d/types.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Sol2D::World {
+
+class Box2dTaskSystem final
+{
+    S2_DISABLE_COPY_AND_MOVE(Box2dTaskSystem)
+
+private:
+    struct Task
+    {
+        std::atomic<int32_t> pending_job_count;
+    };
+
+    struct Job
+    {
+        b2TaskCallback * callback;
+        int32_t start;
+        int32_t end;
+        void * context;
+        Task * task;
+    };
+
+public:
+    static constexpr uint32_t max_worker_count = 64;
+
+public:
+    explicit Box2dTaskSystem(uint32_t _worker_count);
+    ~Box2dTaskSystem();
+    uint32_t getWorkerCount() const;
+    void setSerial(bool _is_serial);
+    void setup(b2WorldDef & _world_def);
+    void execute(b2TaskCallback * _callback, int32_t _item_count, int32_t _min_range, void * _context);
+
+private:
+    static void * enqueueTask(
+        b2TaskCallback * _callback,
+        int32_t _item_count,
+        int32_t _min_range,
+        void * _task_context,
+        void * _user_context);
+    static void finishTask(void * _user_task, void * _user_context);
+    void work(uint32_t _worker_index);
+    bool tryExecuteJob(uint32_t _worker_index);
+    static void executeJob(const Job & _job, uint32_t _worker_index);
+    Task * acquireTask();
+    void releaseTask(Task * _task);
+
+private:
+    uint32_t m_worker_count;
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<Job> m_jobs;
+    std::vector<std::unique_ptr<Task>> m_tasks;
+    std::vector<Task *> m_free_tasks;
+    bool m_is_stopping;
+    bool m_is_serial;
+};
+
+inline uint32_t Box2dTaskSystem::getWorkerCount() const
+{
+    return m_worker_count;
+}
+
+// Makes the world step run in the calling thread only, must be set before the step
+inline void Box2dTaskSystem::setSerial(bool _is_serial)
+{
+    m_is_serial = _is_serial;
+}
+
+} // namespace Sol2D::World
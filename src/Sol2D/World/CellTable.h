@@ -0,0 +1,201 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <Sol2D/Def.h>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Sol2D::World {
+
+// An open addressing hash table keyed by cell keys, see OccupancyGrid::makeCellKey.
+// The slots are stamped with the generation of the table, so clear does not touch them.
+template<typename T>
+class CellTable final
+{
+    S2_DISABLE_COPY_AND_MOVE(CellTable)
+
+    static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+    CellTable() = default;
+    T * find(int64_t _key);
+    std::pair<T *, bool> tryEmplace(int64_t _key, const T & _value);
+    bool erase(int64_t _key);
+    template<typename Predicate>
+    void eraseIf(Predicate _predicate);
+    void clear();
+    size_t getSize() const;
+
+private:
+    struct Slot
+    {
+        int64_t key;
+        T value;
+        uint32_t generation;
+    };
+
+private:
+    bool isOccupied(size_t _index) const;
+    size_t getHomeIndex(int64_t _key) const;
+    size_t findIndex(int64_t _key) const;
+    void eraseAt(size_t _index);
+    void grow();
+
+private:
+    static constexpr size_t s_min_capacity = 64;
+    static constexpr size_t s_npos = static_cast<size_t>(-1);
+    std::vector<Slot> m_slots;
+    uint32_t m_generation = 1;
+    uint32_t m_shift = 64;
+    size_t m_size = 0;
+};
+
+template<typename T>
+inline bool CellTable<T>::isOccupied(size_t _index) const
+{
+    return m_slots[_index].generation == m_generation;
+}
+
+template<typename T>
+inline size_t CellTable<T>::getHomeIndex(int64_t _key) const
+{
+    // Fibonacci hashing spreads the neighboring cells over the table
+    return static_cast<size_t>((static_cast<uint64_t>(_key) * 0x9E3779B97F4A7C15ull) >> m_shift);
+}
+
+template<typename T>
+size_t CellTable<T>::findIndex(int64_t _key) const
+{
+    if(m_size == 0)
+        return s_npos;
+    const size_t mask = m_slots.size() - 1;
+    for(size_t index = getHomeIndex(_key); isOccupied(index); index = (index + 1) & mask)
+    {
+        if(m_slots[index].key == _key)
+            return index;
+    }
+    return s_npos;
+}
+
+template<typename T>
+inline T * CellTable<T>::find(int64_t _key)
+{
+    const size_t index = findIndex(_key);
+    return index == s_npos ? nullptr : &m_slots[index].value;
+}
+
+template<typename T>
+std::pair<T *, bool> CellTable<T>::tryEmplace(int64_t _key, const T & _value)
+{
+    if((m_size + 1) * 2 > m_slots.size())
+        grow();
+    const size_t mask = m_slots.size() - 1;
+    size_t index = getHomeIndex(_key);
+    for(; isOccupied(index); index = (index + 1) & mask)
+    {
+        if(m_slots[index].key == _key)
+            return std::make_pair(&m_slots[index].value, false);
+    }
+    m_slots[index] = Slot { .key = _key, .value = _value, .generation = m_generation };
+    ++m_size;
+    return std::make_pair(&m_slots[index].value, true);
+}
+
+template<typename T>
+bool CellTable<T>::erase(int64_t _key)
+{
+    const size_t index = findIndex(_key);
+    if(index == s_npos)
+        return false;
+    eraseAt(index);
+    return true;
+}
+
+template<typename T>
+void CellTable<T>::eraseAt(size_t _index)
+{
+    // Backward shift deletion, the probe sequences stay unbroken without tombstones
+    const size_t mask = m_slots.size() - 1;
+    size_t hole = _index;
+    for(size_t index = (_index + 1) & mask; isOccupied(index); index = (index + 1) & mask)
+    {
+        const size_t home = getHomeIndex(m_slots[index].key);
+        if(((index - home) & mask) >= ((index - hole) & mask))
+        {
+            m_slots[hole] = m_slots[index];
+            hole = index;
+        }
+    }
+    m_slots[hole].generation = 0;
+    --m_size;
+}
+
+template<typename T>
+template<typename Predicate>
+void CellTable<T>::eraseIf(Predicate _predicate)
+{
+    // A shifted slot takes the place of the erased one, so the index is not advanced after erasing
+    for(size_t index = 0; index < m_slots.size() && m_size > 0;)
+    {
+        if(isOccupied(index) && _predicate(m_slots[index].key))
+            eraseAt(index);
+        else
+            ++index;
+    }
+}
+
+template<typename T>
+void CellTable<T>::clear()
+{
+    m_size = 0;
+    if(++m_generation == 0)
+    {
+        for(Slot & slot : m_slots)
+            slot.generation = 0;
+        m_generation = 1;
+    }
+}
+
+template<typename T>
+inline size_t CellTable<T>::getSize() const
+{
+    return m_size;
+}
+
+template<typename T>
+void CellTable<T>::grow()
+{
+    std::vector<Slot> old_slots(m_slots.empty() ? s_min_capacity : m_slots.size() * 2);
+    old_slots.swap(m_slots);
+    m_shift = 64 - static_cast<uint32_t>(std::countr_zero(m_slots.size()));
+    const uint32_t old_generation = m_generation;
+    m_generation = 1;
+    m_size = 0;
+    for(const Slot & slot : old_slots)
+    {
+        if(slot.generation == old_generation)
+            tryEmplace(slot.key, slot.value);
+    }
+}
+
+} // namespace Sol2D::World
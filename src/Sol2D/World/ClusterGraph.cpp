@@ -0,0 +1,206 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <Sol2D/World/ClusterGraph.h>
+#include <Sol2D/World/AStar.h>
+#include <algorithm>
+#include <limits>
+
+using namespace Sol2D;
+using namespace Sol2D::World;
+
+namespace {
+
+constexpr int32_t gc_min_wide_entrance_length = 6;
+constexpr float gc_infinity = std::numeric_limits<float>::infinity();
+
+} // namespace
+
+std::optional<size_t> ClusterGraph::Cluster::findEntrance(const CellPoint & _cell) const
+{
+    for(size_t i = 0; i < entrances.size(); ++i)
+    {
+        if(entrances[i] == _cell)
+            return i;
+    }
+    return std::nullopt;
+}
+
+ClusterGraph::ClusterGraph(OccupancyGrid & _grid, bool _allow_diagonal_steps) :
+    mr_grid(_grid),
+    m_allow_diagonal_steps(_allow_diagonal_steps)
+{
+}
+
+const ClusterGraph::Cluster & ClusterGraph::getCluster(const CellPoint & _cluster)
+{
+    auto [it, is_inserted] = m_clusters.try_emplace(OccupancyGrid::makeCellKey(_cluster.x, _cluster.y));
+    if(is_inserted)
+        buildCluster(_cluster, it->second);
+    return it->second;
+}
+
+void ClusterGraph::buildCluster(const CellPoint & _cluster, Cluster & _result)
+{
+    const CellRect rect = getClusterRect(_cluster);
+    const int32_t right = rect.x + cluster_size - 1;
+    const int32_t bottom = rect.y + cluster_size - 1;
+    findEntrances({ .x = rect.x, .y = rect.y }, { .x = rect.x - 1, .y = rect.y }, { .x = 0, .y = 1 }, _result);
+    findEntrances({ .x = right, .y = rect.y }, { .x = right + 1, .y = rect.y }, { .x = 0, .y = 1 }, _result);
+    findEntrances({ .x = rect.x, .y = rect.y }, { .x = rect.x, .y = rect.y - 1 }, { .x = 1, .y = 0 }, _result);
+    findEntrances({ .x = rect.x, .y = bottom }, { .x = rect.x, .y = bottom + 1 }, { .x = 1, .y = 0 }, _result);
+    const size_t count = _result.entrances.size();
+    _result.costs.resize(count * count);
+    if(count == 0)
+        return;
+    loadBlockedCells(rect);
+    for(size_t from = 0; from < count; ++from)
+    {
+        runDijkstra(getLocalIndex(_result.entrances[from]), m_distances);
+        for(size_t to = 0; to < count; ++to)
+            _result.costs[from * count + to] = m_distances[getLocalIndex(_result.entrances[to])];
+    }
+}
+
+// Both clusters find the same entrances on the shared border, so each cluster can be built independently
+void ClusterGraph::findEntrances(
+    const CellPoint & _first_inner,
+    const CellPoint & _first_outer,
+    const CellPoint & _step,
+    Cluster & _result)
+{
+    auto add_entrance = [&](int32_t __index) {
+        const CellPoint cell { .x = _first_inner.x + _step.x * __index, .y = _first_inner.y + _step.y * __index };
+        if(!_result.findEntrance(cell).has_value())
+            _result.entrances.push_back(cell);
+    };
+    int32_t run_start = -1;
+    for(int32_t i = 0; i <= cluster_size; ++i)
+    {
+        const bool is_free = i < cluster_size &&
+            !mr_grid.isBlocked(_first_inner.x + _step.x * i, _first_inner.y + _step.y * i) &&
+            !mr_grid.isBlocked(_first_outer.x + _step.x * i, _first_outer.y + _step.y * i);
+        if(is_free)
+        {
+            if(run_start < 0)
+                run_start = i;
+            continue;
+        }
+        if(run_start < 0)
+            continue;
+        const int32_t run_end = i - 1;
+        if(run_end - run_start + 1 >= gc_min_wide_entrance_length)
+        {
+            add_entrance(run_start);
+            add_entrance(run_end);
+        }
+        else
+        {
+            add_entrance((run_start + run_end) / 2);
+        }
+        run_start = -1;
+    }
+}
+
+void ClusterGraph::calculateDistances(const CellPoint & _from, std::vector<float> & _distances)
+{
+    loadBlockedCells(getClusterRect(getClusterOf(_from)));
+    runDijkstra(getLocalIndex(_from), _distances);
+}
+
+void ClusterGraph::loadBlockedCells(const CellRect & _rect)
+{
+    m_blocked_cells.resize(cluster_size * cluster_size);
+    for(int32_t y = 0; y < cluster_size; ++y)
+    {
+        for(int32_t x = 0; x < cluster_size; ++x)
+            m_blocked_cells[y * cluster_size + x] = mr_grid.isBlocked(_rect.x + x, _rect.y + y);
+    }
+}
+
+void ClusterGraph::runDijkstra(size_t _from, std::vector<float> & _distances)
+{
+    auto is_free = [this](int32_t __x, int32_t __y) {
+        return __x >= 0 && __y >= 0 && __x < cluster_size && __y < cluster_size &&
+            !m_blocked_cells[__y * cluster_size + __x];
+    };
+    auto relax = [this, &_distances](int32_t __x, int32_t __y, float __distance) {
+        const size_t index = static_cast<size_t>(__y) * cluster_size + __x;
+        if(__distance >= _distances[index])
+            return;
+        _distances[index] = __distance;
+        m_open_cells.emplace_back(__distance, index);
+        std::push_heap(m_open_cells.begin(), m_open_cells.end(), std::greater<>());
+    };
+
+    _distances.assign(cluster_size * cluster_size, gc_infinity);
+    _distances[_from] = .0f;
+    m_open_cells.clear();
+    m_open_cells.emplace_back(.0f, _from);
+    while(!m_open_cells.empty())
+    {
+        std::pop_heap(m_open_cells.begin(), m_open_cells.end(), std::greater<>());
+        const auto [distance, index] = m_open_cells.back();
+        m_open_cells.pop_back();
+        if(distance > _distances[index])
+            continue;
+        const int32_t x = static_cast<int32_t>(index % cluster_size);
+        const int32_t y = static_cast<int32_t>(index / cluster_size);
+        const bool is_left_free = is_free(x - 1, y);
+        const bool is_right_free = is_free(x + 1, y);
+        const bool is_top_free = is_free(x, y - 1);
+        const bool is_bottom_free = is_free(x, y + 1);
+        if(is_left_free) relax(x - 1, y, distance + AStar::straight_step_cost);
+        if(is_right_free) relax(x + 1, y, distance + AStar::straight_step_cost);
+        if(is_top_free) relax(x, y - 1, distance + AStar::straight_step_cost);
+        if(is_bottom_free) relax(x, y + 1, distance + AStar::straight_step_cost);
+        if(!m_allow_diagonal_steps)
+            continue;
+        if(is_left_free && is_top_free && is_free(x - 1, y - 1))
+            relax(x - 1, y - 1, distance + AStar::diagonal_step_cost);
+        if(is_right_free && is_top_free && is_free(x + 1, y - 1))
+            relax(x + 1, y - 1, distance + AStar::diagonal_step_cost);
+        if(is_left_free && is_bottom_free && is_free(x - 1, y + 1))
+            relax(x - 1, y + 1, distance + AStar::diagonal_step_cost);
+        if(is_right_free && is_bottom_free && is_free(x + 1, y + 1))
+            relax(x + 1, y + 1, distance + AStar::diagonal_step_cost);
+    }
+}
+
+void ClusterGraph::invalidate()
+{
+    m_clusters.clear();
+}
+
+void ClusterGraph::invalidate(const CellRect & _rect)
+{
+    // The entrances of a cluster depend on the cells next to its borders
+    const CellPoint first = getClusterOf({ .x = _rect.x - 1, .y = _rect.y - 1 });
+    const CellPoint last = getClusterOf({ .x = _rect.x + _rect.w, .y = _rect.y + _rect.h });
+    const CellRect clusters { .x = first.x, .y = first.y, .w = last.x - first.x + 1, .h = last.y - first.y + 1 };
+    if(static_cast<size_t>(clusters.w) * static_cast<size_t>(clusters.h) > m_clusters.size())
+    {
+        std::erase_if(m_clusters, [&clusters](const auto & __pair) {
+            return clusters.contains(OccupancyGrid::splitCellKey(__pair.first));
+        });
+        return;
+    }
+    for(int32_t y = clusters.y; y < clusters.y + clusters.h; ++y)
+    {
+        for(int32_t x = clusters.x; x < clusters.x + clusters.w; ++x)
+            m_clusters.erase(OccupancyGrid::makeCellKey(x, y));
+    }
+}
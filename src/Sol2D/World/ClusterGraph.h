@@ -0,0 +1,113 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <Sol2D/World/OccupancyGrid.h>
+#include <optional>
+#include <vector>
+
+namespace Sol2D::World {
+
+// An abstract graph for the hierarchical path finding.
+// The occupancy grid is divided into square clusters, the entrances between the neighboring clusters
+// and the costs of the paths between the entrances of a cluster are calculated when the cluster
+// is visited for the first time.
+class ClusterGraph final
+{
+    S2_DISABLE_COPY_AND_MOVE(ClusterGraph)
+
+public:
+    static constexpr int32_t cluster_size = 16;
+
+    struct Cluster
+    {
+        std::vector<CellPoint> entrances;
+        std::vector<float> costs; // The square matrix of the costs between the entrances, infinity if unreachable
+
+        std::optional<size_t> findEntrance(const CellPoint & _cell) const;
+        float getCost(size_t _from, size_t _to) const;
+    };
+
+    ClusterGraph(OccupancyGrid & _grid, bool _allow_diagonal_steps);
+    OccupancyGrid & getGrid();
+    bool doesAllowDiagonalSteps() const;
+    const Cluster & getCluster(const CellPoint & _cluster);
+    void calculateDistances(const CellPoint & _from, std::vector<float> & _distances);
+    void invalidate();
+    void invalidate(const CellRect & _rect);
+    static CellPoint getClusterOf(const CellPoint & _cell);
+    static CellRect getClusterRect(const CellPoint & _cluster);
+    static size_t getLocalIndex(const CellPoint & _cell);
+
+private:
+    void buildCluster(const CellPoint & _cluster, Cluster & _result);
+    void findEntrances(const CellPoint & _first_inner, const CellPoint & _first_outer, const CellPoint & _step, Cluster & _result);
+    void loadBlockedCells(const CellRect & _rect);
+    void runDijkstra(size_t _from, std::vector<float> & _distances);
+
+private:
+    OccupancyGrid & mr_grid;
+    const bool m_allow_diagonal_steps;
+    std::unordered_map<int64_t, Cluster> m_clusters;
+    std::vector<bool> m_blocked_cells;
+    std::vector<float> m_distances;
+    std::vector<std::pair<float, size_t>> m_open_cells;
+};
+
+inline float ClusterGraph::Cluster::getCost(size_t _from, size_t _to) const
+{
+    return costs[_from * entrances.size() + _to];
+}
+
+inline OccupancyGrid & ClusterGraph::getGrid()
+{
+    return mr_grid;
+}
+
+inline bool ClusterGraph::doesAllowDiagonalSteps() const
+{
+    return m_allow_diagonal_steps;
+}
+
+inline CellPoint ClusterGraph::getClusterOf(const CellPoint & _cell)
+{
+    // Rounding towards negative infinity
+    return CellPoint
+    {
+        .x = _cell.x >= 0 ? _cell.x / cluster_size : (_cell.x - cluster_size + 1) / cluster_size,
+        .y = _cell.y >= 0 ? _cell.y / cluster_size : (_cell.y - cluster_size + 1) / cluster_size
+    };
+}
+
+inline CellRect ClusterGraph::getClusterRect(const CellPoint & _cluster)
+{
+    return CellRect
+    {
+        .x = _cluster.x * cluster_size,
+        .y = _cluster.y * cluster_size,
+        .w = cluster_size,
+        .h = cluster_size
+    };
+}
+
+inline size_t ClusterGraph::getLocalIndex(const CellPoint & _cell)
+{
+    const CellPoint cluster = getClusterOf(_cell);
+    return static_cast<size_t>(_cell.y - cluster.y * cluster_size) * cluster_size + (_cell.x - cluster.x * cluster_size);
+}
+
+} // namespace Sol2D::World
@@ -19,6 +19,7 @@
 #include <Sol2D/MediaLayer/MediaLayer.h>
 #include <string>
 #include <optional>
+#include <span>
 
 namespace Sol2D::World {
 
@@ -27,6 +28,7 @@ struct ContactSide
     uint64_t body_id;
     std::string shape_key;
     std::optional<uint32_t> tile_map_object_id;
+    std::optional<std::string> tag;
 };
 
 struct Contact
@@ -48,6 +50,32 @@ struct PreSolveContact
     const b2Manifold * manifold;
 };
 
+enum class ContactType
+{
+    Begin = 0,
+    End = 1,
+    SensorBegin = 2,
+    SensorEnd = 3
+};
+
+// For sensor contacts the side A is the sensor and the side B is the visitor
+struct ContactRecord
+{
+    ContactType type;
+    ContactSide side_a;
+    ContactSide side_b;
+};
+
+struct ContactFilter
+{
+    std::optional<uint64_t> body_id;
+    std::optional<std::string> shape_key;
+    std::optional<std::string> tag;
+
+    bool matches(const ContactSide & _side) const;
+    bool matches(const ContactRecord & _record) const;
+};
+
 class ContactObserver
 {
 public:
@@ -59,4 +87,23 @@ public:
     virtual bool preSolveContact(const PreSolveContact & _contact) = 0;
 };
 
+class ContactBatchObserver
+{
+public:
+    virtual ~ContactBatchObserver() { }
+    virtual void onContacts(std::span<const ContactRecord> _contacts) = 0;
+};
+
+inline bool ContactFilter::matches(const ContactSide & _side) const
+{
+    return (!body_id.has_value() || body_id.value() == _side.body_id) &&
+        (!shape_key.has_value() || shape_key.value() == _side.shape_key) &&
+        (!tag.has_value() || tag == _side.tag);
+}
+
+inline bool ContactFilter::matches(const ContactRecord & _record) const
+{
+    return matches(_record.side_a) || matches(_record.side_b);
+}
+
 } // namespace Sol2D::World
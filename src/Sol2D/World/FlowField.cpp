@@ -0,0 +1,154 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <Sol2D/World/FlowField.h>
+#include <Sol2D/World/AStar.h>
+#include <algorithm>
+#include <limits>
+
+using namespace Sol2D;
+using namespace Sol2D::World;
+
+namespace {
+
+constexpr float gc_infinity = std::numeric_limits<float>::infinity();
+
+// The straight directions go first, the diagonal ones are used only if allowed
+constexpr CellPoint gc_directions[] =
+{
+    { .x = -1, .y = 0 },
+    { .x = 1, .y = 0 },
+    { .x = 0, .y = -1 },
+    { .x = 0, .y = 1 },
+    { .x = -1, .y = -1 },
+    { .x = 1, .y = -1 },
+    { .x = -1, .y = 1 },
+    { .x = 1, .y = 1 }
+};
+
+constexpr uint8_t gc_straight_direction_count = 4;
+constexpr uint8_t gc_direction_count = 8;
+
+} // namespace
+
+FlowField::FlowField(const CellRect & _area, const b2Vec2 & _cell_size, bool _allow_diagonal_steps, bool _avoid_sensors) :
+    m_area(_area),
+    m_cell_size(_cell_size),
+    m_allow_diagonal_steps(_allow_diagonal_steps),
+    m_avoid_sensors(_avoid_sensors),
+    m_goal(b2Vec2_zero),
+    m_is_outdated(true)
+{
+}
+
+void FlowField::build(OccupancyGrid & _grid, const b2Vec2 & _goal)
+{
+    m_goal = _goal;
+    m_is_outdated = false;
+    const size_t cell_count = static_cast<size_t>(m_area.w) * static_cast<size_t>(m_area.h);
+    m_blocked_cells.resize(cell_count);
+    for(int32_t y = 0; y < m_area.h; ++y)
+    {
+        for(int32_t x = 0; x < m_area.w; ++x)
+            m_blocked_cells[y * m_area.w + x] = _grid.isBlocked(m_area.x + x, m_area.y + y);
+    }
+    m_costs.assign(cell_count, gc_infinity);
+    m_directions.assign(cell_count, s_no_direction);
+    const std::optional<size_t> goal_index = getIndex(_goal);
+    if(!goal_index.has_value() || m_blocked_cells[goal_index.value()])
+        return;
+
+    const uint8_t direction_count = m_allow_diagonal_steps ? gc_direction_count : gc_straight_direction_count;
+    auto can_step = [this](int32_t __x, int32_t __y, const CellPoint & __direction) {
+        if(!isFree(__x + __direction.x, __y + __direction.y))
+            return false;
+        // Diagonal steps must not cut the corners of obstacles
+        return __direction.x == 0 || __direction.y == 0 ||
+            (isFree(__x + __direction.x, __y) && isFree(__x, __y + __direction.y));
+    };
+
+    m_costs[goal_index.value()] = .0f;
+    m_open_cells.clear();
+    m_open_cells.emplace_back(.0f, static_cast<uint32_t>(goal_index.value()));
+    while(!m_open_cells.empty())
+    {
+        std::pop_heap(m_open_cells.begin(), m_open_cells.end(), std::greater<>());
+        const auto [cost, index] = m_open_cells.back();
+        m_open_cells.pop_back();
+        if(cost > m_costs[index])
+            continue;
+        const int32_t x = static_cast<int32_t>(index % m_area.w);
+        const int32_t y = static_cast<int32_t>(index / m_area.w);
+        for(uint8_t i = 0; i < direction_count; ++i)
+        {
+            const CellPoint & direction = gc_directions[i];
+            if(!can_step(x, y, direction))
+                continue;
+            const uint32_t next_index = (y + direction.y) * m_area.w + x + direction.x;
+            const float next_cost = cost + (i < gc_straight_direction_count ? AStar::straight_step_cost : AStar::diagonal_step_cost);
+            if(next_cost >= m_costs[next_index])
+                continue;
+            m_costs[next_index] = next_cost;
+            m_open_cells.emplace_back(next_cost, next_index);
+            std::push_heap(m_open_cells.begin(), m_open_cells.end(), std::greater<>());
+        }
+    }
+
+    for(int32_t y = 0; y < m_area.h; ++y)
+    {
+        for(int32_t x = 0; x < m_area.w; ++x)
+        {
+            const size_t index = y * m_area.w + x;
+            if(m_costs[index] == gc_infinity || index == goal_index.value())
+                continue;
+            float best_cost = m_costs[index];
+            for(uint8_t i = 0; i < direction_count; ++i)
+            {
+                const CellPoint & direction = gc_directions[i];
+                if(!can_step(x, y, direction))
+                    continue;
+                const float cost = m_costs[(y + direction.y) * m_area.w + x + direction.x];
+                if(cost < best_cost)
+                {
+                    best_cost = cost;
+                    m_directions[index] = i;
+                }
+            }
+        }
+    }
+}
+
+// Returns the zero vector in the goal cell and nothing if the goal is unreachable from the point
+std::optional<b2Vec2> FlowField::getDirection(const b2Vec2 & _point) const
+{
+    const std::optional<size_t> index = getIndex(_point);
+    if(!index.has_value() || m_costs.empty() || m_costs[index.value()] == gc_infinity)
+        return std::nullopt;
+    const uint8_t direction_index = m_directions[index.value()];
+    if(direction_index == s_no_direction)
+        return b2Vec2_zero;
+    const CellPoint & direction = gc_directions[direction_index];
+    return b2Normalize(b2Vec2(direction.x * m_cell_size.x, direction.y * m_cell_size.y));
+}
+
+std::optional<size_t> FlowField::getIndex(const b2Vec2 & _point) const
+{
+    const int32_t x = static_cast<int32_t>(std::round(_point.x / m_cell_size.x)) - m_area.x;
+    const int32_t y = static_cast<int32_t>(std::round(_point.y / m_cell_size.y)) - m_area.y;
+    if(x < 0 || y < 0 || x >= m_area.w || y >= m_area.h)
+        return std::nullopt;
+    return static_cast<size_t>(y) * m_area.w + x;
+}
@@ -0,0 +1,103 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <Sol2D/World/OccupancyGrid.h>
+#include <Sol2D/MediaLayer/MediaLayer.h>
+#include <optional>
+#include <vector>
+
+namespace Sol2D::World {
+
+struct FlowFieldOptions
+{
+    FlowFieldOptions() :
+        allow_diagonal_steps(true),
+        avoid_sensors(false)
+    {
+    }
+
+    std::optional<SDL_FRect> area;
+    std::optional<FSize> cell_size;
+    bool allow_diagonal_steps;
+    bool avoid_sensors;
+};
+
+// Directions towards the goal for all the cells of the area, built by a single Dijkstra pass from the goal.
+class FlowField final
+{
+    S2_DISABLE_COPY_AND_MOVE(FlowField)
+
+public:
+    FlowField(const CellRect & _area, const b2Vec2 & _cell_size, bool _allow_diagonal_steps, bool _avoid_sensors);
+    const b2Vec2 & getCellSize() const;
+    bool doesAvoidSensors() const;
+    const b2Vec2 & getGoal() const;
+    bool isOutdated() const;
+    void invalidate();
+    void build(OccupancyGrid & _grid, const b2Vec2 & _goal);
+    std::optional<b2Vec2> getDirection(const b2Vec2 & _point) const;
+
+private:
+    std::optional<size_t> getIndex(const b2Vec2 & _point) const;
+    bool isFree(int32_t _x, int32_t _y) const;
+
+private:
+    static constexpr uint8_t s_no_direction = 0xFF;
+    const CellRect m_area;
+    const b2Vec2 m_cell_size;
+    const bool m_allow_diagonal_steps;
+    const bool m_avoid_sensors;
+    b2Vec2 m_goal;
+    bool m_is_outdated;
+    std::vector<bool> m_blocked_cells;
+    std::vector<float> m_costs;
+    std::vector<uint8_t> m_directions;
+    std::vector<std::pair<float, uint32_t>> m_open_cells;
+};
+
+inline const b2Vec2 & FlowField::getCellSize() const
+{
+    return m_cell_size;
+}
+
+inline bool FlowField::doesAvoidSensors() const
+{
+    return m_avoid_sensors;
+}
+
+inline const b2Vec2 & FlowField::getGoal() const
+{
+    return m_goal;
+}
+
+inline bool FlowField::isOutdated() const
+{
+    return m_is_outdated;
+}
+
+inline void FlowField::invalidate()
+{
+    m_is_outdated = true;
+}
+
+inline bool FlowField::isFree(int32_t _x, int32_t _y) const
+{
+    return _x >= 0 && _y >= 0 && _x < m_area.w && _y < m_area.h && !m_blocked_cells[_y * m_area.w + _x];
+}
+
+} // namespace Sol2D::World
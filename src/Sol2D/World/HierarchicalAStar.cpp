@@ -0,0 +1,182 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <Sol2D/World/HierarchicalAStar.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace Sol2D;
+using namespace Sol2D::World;
+
+std::optional<AStarResult> HierarchicalAStar::findPath(
+    ClusterGraph & _graph,
+    AStar & _refiner,
+    const b2Vec2 & _start,
+    const b2Vec2 & _destination,
+    const AStarOptions & _options)
+{
+    OccupancyGrid & grid = _graph.getGrid();
+    m_start = { .x = grid.getCellX(_start.x), .y = grid.getCellY(_start.y) };
+    m_destination = { .x = grid.getCellX(_destination.x), .y = grid.getCellY(_destination.y) };
+    m_start_cluster = ClusterGraph::getClusterOf(m_start);
+    m_destination_cluster = ClusterGraph::getClusterOf(m_destination);
+    m_allow_diagonal_steps = _graph.doesAllowDiagonalSteps();
+    _graph.calculateDistances(m_start, m_start_distances);
+    m_is_destination_reachable = !grid.isBlocked(m_destination.x, m_destination.y);
+    if(m_is_destination_reachable)
+        _graph.calculateDistances(m_destination, m_destination_distances);
+    m_nodes.clear();
+    m_node_indices.clear();
+    m_open_nodes.clear();
+    m_nodes.push_back(Node { .cell = m_start, .cost = .0f, .parent = s_no_parent, .is_closed = false });
+    m_node_indices.emplace(OccupancyGrid::makeCellKey(m_start.x, m_start.y), 0);
+    m_open_nodes.push_back(OpenNode {
+        .full_cost = AStar::estimate(m_start, m_destination, m_allow_diagonal_steps),
+        .index = 0
+    });
+
+    uint32_t end_index = 0;
+    bool is_complete = false;
+    float closest_estimate = m_open_nodes.front().full_cost;
+    uint32_t expansion_count = 0;
+    while(!m_open_nodes.empty())
+    {
+        std::pop_heap(m_open_nodes.begin(), m_open_nodes.end());
+        const uint32_t index = m_open_nodes.back().index;
+        m_open_nodes.pop_back();
+        Node & node = m_nodes[index];
+        if(node.is_closed)
+            continue;
+        node.is_closed = true;
+        if(node.cell == m_destination)
+        {
+            end_index = index;
+            is_complete = true;
+            break;
+        }
+        const float node_estimate = AStar::estimate(node.cell, m_destination, m_allow_diagonal_steps);
+        if(node_estimate < closest_estimate)
+        {
+            closest_estimate = node_estimate;
+            end_index = index;
+        }
+        if(++expansion_count > _options.max_expansions)
+            break;
+        expandNode(index, _graph);
+    }
+    if(!is_complete && !_options.allow_partial_path)
+        return std::nullopt;
+    if(!refinePath(end_index, _graph, _refiner))
+        return std::nullopt;
+    return AStarResult { .points = AStar::makeWaypoints(grid, _start, m_cells), .is_complete = is_complete };
+}
+
+void HierarchicalAStar::expandNode(uint32_t _index, ClusterGraph & _graph)
+{
+    const CellPoint cell = m_nodes[_index].cell;
+    const float cost = m_nodes[_index].cost;
+    const CellPoint cluster_point = ClusterGraph::getClusterOf(cell);
+    const ClusterGraph::Cluster & cluster = _graph.getCluster(cluster_point);
+    if(cell == m_start)
+    {
+        for(const CellPoint & entrance : cluster.entrances)
+        {
+            const float distance = m_start_distances[ClusterGraph::getLocalIndex(entrance)];
+            if(std::isfinite(distance))
+                relaxNode(entrance, cost + distance, _index);
+        }
+    }
+    if(m_is_destination_reachable && cluster_point == m_destination_cluster)
+    {
+        const float distance = m_destination_distances[ClusterGraph::getLocalIndex(cell)];
+        if(std::isfinite(distance))
+            relaxNode(m_destination, cost + distance, _index);
+    }
+    const std::optional<size_t> entrance_index = cluster.findEntrance(cell);
+    if(!entrance_index.has_value())
+        return;
+    for(size_t i = 0; i < cluster.entrances.size(); ++i)
+    {
+        const float distance = cluster.getCost(entrance_index.value(), i);
+        if(i != entrance_index.value() && std::isfinite(distance))
+            relaxNode(cluster.entrances[i], cost + distance, _index);
+    }
+    const CellRect rect = ClusterGraph::getClusterRect(cluster_point);
+    const CellPoint neighbors[] =
+    {
+        { .x = cell.x - 1, .y = cell.y },
+        { .x = cell.x + 1, .y = cell.y },
+        { .x = cell.x, .y = cell.y - 1 },
+        { .x = cell.x, .y = cell.y + 1 }
+    };
+    for(const CellPoint & neighbor : neighbors)
+    {
+        if(rect.contains(neighbor))
+            continue;
+        const ClusterGraph::Cluster & neighbor_cluster = _graph.getCluster(ClusterGraph::getClusterOf(neighbor));
+        if(neighbor_cluster.findEntrance(neighbor).has_value())
+            relaxNode(neighbor, cost + AStar::straight_step_cost, _index);
+    }
+}
+
+void HierarchicalAStar::relaxNode(const CellPoint & _cell, float _cost, uint32_t _parent)
+{
+    auto [it, is_inserted] = m_node_indices.try_emplace(
+        OccupancyGrid::makeCellKey(_cell.x, _cell.y),
+        static_cast<uint32_t>(m_nodes.size()));
+    if(is_inserted)
+    {
+        m_nodes.push_back(Node { .cell = _cell, .cost = _cost, .parent = _parent, .is_closed = false });
+    }
+    else
+    {
+        Node & node = m_nodes[it->second];
+        if(node.is_closed || node.cost <= _cost)
+            return;
+        node.cost = _cost;
+        node.parent = _parent;
+    }
+    m_open_nodes.push_back(OpenNode {
+        .full_cost = _cost + AStar::estimate(_cell, m_destination, m_allow_diagonal_steps),
+        .index = it->second
+    });
+    std::push_heap(m_open_nodes.begin(), m_open_nodes.end());
+}
+
+bool HierarchicalAStar::refinePath(uint32_t _end_index, ClusterGraph & _graph, AStar & _refiner)
+{
+    m_abstract_path.clear();
+    for(uint32_t index = _end_index; index != s_no_parent; index = m_nodes[index].parent)
+        m_abstract_path.push_back(m_nodes[index].cell);
+    std::reverse(m_abstract_path.begin(), m_abstract_path.end());
+    m_cells.clear();
+    m_cells.push_back(m_abstract_path.front());
+    for(size_t i = 1; i < m_abstract_path.size(); ++i)
+    {
+        const CellPoint & from = m_abstract_path[i - 1];
+        const CellPoint & to = m_abstract_path[i];
+        const CellPoint cluster = ClusterGraph::getClusterOf(from);
+        if(cluster != ClusterGraph::getClusterOf(to))
+        {
+            m_cells.push_back(to); // A step through an entrance
+            continue;
+        }
+        const CellRect bounds = ClusterGraph::getClusterRect(cluster);
+        if(!_refiner.findCellPath(_graph.getGrid(), from, to, bounds, m_allow_diagonal_steps, m_cells))
+            return false;
+    }
+    return true;
+}
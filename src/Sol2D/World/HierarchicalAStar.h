@@ -0,0 +1,80 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <Sol2D/World/AStar.h>
+#include <Sol2D/World/ClusterGraph.h>
+
+namespace Sol2D::World {
+
+// Searches the abstract graph of the clusters first, then refines the found route cluster by cluster.
+// The number of expansions limits the abstract nodes.
+class HierarchicalAStar final
+{
+    S2_DISABLE_COPY_AND_MOVE(HierarchicalAStar)
+
+public:
+    HierarchicalAStar() = default;
+    std::optional<AStarResult> findPath(
+        ClusterGraph & _graph,
+        AStar & _refiner,
+        const b2Vec2 & _start,
+        const b2Vec2 & _destination,
+        const AStarOptions & _options);
+
+private:
+    struct Node
+    {
+        CellPoint cell;
+        float cost;
+        uint32_t parent;
+        bool is_closed;
+    };
+
+    struct OpenNode
+    {
+        float full_cost;
+        uint32_t index;
+
+        bool operator < (const OpenNode & _other) const
+        {
+            return full_cost > _other.full_cost;
+        }
+    };
+
+    void expandNode(uint32_t _index, ClusterGraph & _graph);
+    void relaxNode(const CellPoint & _cell, float _cost, uint32_t _parent);
+    bool refinePath(uint32_t _end_index, ClusterGraph & _graph, AStar & _refiner);
+
+private:
+    static constexpr uint32_t s_no_parent = static_cast<uint32_t>(-1);
+    CellPoint m_start = { .x = 0, .y = 0 };
+    CellPoint m_destination = { .x = 0, .y = 0 };
+    CellPoint m_start_cluster = { .x = 0, .y = 0 };
+    CellPoint m_destination_cluster = { .x = 0, .y = 0 };
+    bool m_is_destination_reachable = false;
+    bool m_allow_diagonal_steps = false;
+    std::vector<float> m_start_distances;
+    std::vector<float> m_destination_distances;
+    std::vector<Node> m_nodes;
+    std::unordered_map<int64_t, uint32_t> m_node_indices;
+    std::vector<OpenNode> m_open_nodes;
+    std::vector<CellPoint> m_abstract_path;
+    std::vector<CellPoint> m_cells;
+};
+
+} // namespace Sol2D::World
@@ -0,0 +1,319 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <Sol2D/World/OccupancyGrid.h>
+#include <Sol2D/World/ClusterGraph.h>
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+using namespace Sol2D;
+using namespace Sol2D::World;
+
+namespace {
+
+constexpr float gc_cell_size_tolerance = 0.001f;
+
+} // namespace
+
+OccupancySnapshot::OccupancySnapshot(
+    const b2Vec2 & _cell_size,
+    bool _avoid_sensors,
+    ChunkMap && _chunks
+) :
+    m_cell_size(_cell_size),
+    m_avoid_sensors(_avoid_sensors),
+    m_chunks(std::move(_chunks))
+{
+}
+
+bool OccupancySnapshot::isBlocked(int32_t _x, int32_t _y) const
+{
+    const CellPoint cell { .x = _x, .y = _y };
+    const CellPoint chunk = getChunkOf(cell);
+    auto it = m_chunks.find(OccupancyGrid::makeCellKey(chunk.x, chunk.y));
+    return it != m_chunks.end() && it->second->test(getLocalIndex(cell));
+}
+
+OccupancyGrid::OccupancyGrid(b2WorldId _world_id, const b2Vec2 & _cell_size, bool _avoid_sensors) :
+    m_world_id(_world_id),
+    m_cell_size(_cell_size),
+    m_avoid_sensors(_avoid_sensors)
+{
+}
+
+OccupancyGrid::OccupancyGrid(std::shared_ptr<const OccupancySnapshot> _snapshot) :
+    m_world_id(b2_nullWorldId),
+    m_snapshot_ptr(_snapshot),
+    m_cell_size(_snapshot->getCellSize()),
+    m_avoid_sensors(_snapshot->doesAvoidSensors())
+{
+}
+
+CellRect OccupancyGrid::getCellRect(const b2AABB & _aabb) const
+{
+    // Cells touching the bounds are included as well
+    const int32_t left = getCellX(_aabb.lowerBound.x) - 1;
+    const int32_t top = getCellY(_aabb.lowerBound.y) - 1;
+    const int32_t right = getCellX(_aabb.upperBound.x) + 1;
+    const int32_t bottom = getCellY(_aabb.upperBound.y) + 1;
+    return CellRect { .x = left, .y = top, .w = right - left + 1, .h = bottom - top + 1 };
+}
+
+void OccupancyGrid::invalidate(const CellRect & _rect)
+{
+    if(static_cast<size_t>(_rect.w) * static_cast<size_t>(_rect.h) > m_cells.getSize())
+    {
+        m_cells.eraseIf([&_rect](int64_t __key) {
+            return _rect.contains(OccupancyGrid::splitCellKey(__key));
+        });
+        return;
+    }
+    for(int32_t y = _rect.y; y < _rect.y + _rect.h; ++y)
+    {
+        for(int32_t x = _rect.x; x < _rect.x + _rect.w; ++x)
+            m_cells.erase(makeCellKey(x, y));
+    }
+}
+
+bool OccupancyGrid::queryCell(int32_t _x, int32_t _y) const
+{
+    if(m_snapshot_ptr)
+        return m_snapshot_ptr->isBlocked(_x, _y);
+    struct OverlapResult
+    {
+        static bool callback(b2ShapeId __shape_id, void * __context)
+        {
+            OverlapResult * self = static_cast<OverlapResult *>(__context);
+            if(b2Body_GetType(b2Shape_GetBody(__shape_id)) != b2_staticBody ||
+                (b2Shape_IsSensor(__shape_id) && !self->avoid_sensors))
+            {
+                return true;
+            }
+            self->is_blocked = true;
+            return false;
+        }
+
+        bool avoid_sensors;
+        bool is_blocked;
+    };
+    const b2Polygon box = b2MakeBox(m_cell_size.x / 2, m_cell_size.y / 2);
+    const b2Transform transform { .p = getCellCenter(_x, _y), .q = b2Rot_identity };
+    OverlapResult result { .avoid_sensors = m_avoid_sensors, .is_blocked = false };
+    b2World_OverlapPolygon(
+        m_world_id,
+        &box,
+        transform,
+        b2DefaultQueryFilter(),
+        &OverlapResult::callback,
+        &result);
+    return result.is_blocked;
+}
+
+OccupancyGridCache::Entry::Entry(b2WorldId _world_id, const b2Vec2 & _cell_size, bool _avoid_sensors) :
+    grid(_world_id, _cell_size, _avoid_sensors)
+{
+}
+
+OccupancyGridCache::Entry::~Entry() = default;
+
+OccupancyGridCache::~OccupancyGridCache() = default;
+
+OccupancyGridCache::Entry & OccupancyGridCache::getEntry(
+    b2WorldId _world_id,
+    const b2Vec2 & _cell_size,
+    bool _avoid_sensors)
+{
+    for(auto it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if(it->grid.doesAvoidSensors() == _avoid_sensors &&
+            std::abs(it->grid.getCellSize().x - _cell_size.x) < gc_cell_size_tolerance &&
+            std::abs(it->grid.getCellSize().y - _cell_size.y) < gc_cell_size_tolerance)
+        {
+            m_entries.splice(m_entries.begin(), m_entries, it);
+            return m_entries.front();
+        }
+    }
+    if(m_entries.size() == s_max_grid_count)
+        m_entries.pop_back();
+    return m_entries.emplace_front(_world_id, _cell_size, _avoid_sensors);
+}
+
+OccupancyGrid & OccupancyGridCache::getGrid(b2WorldId _world_id, const b2Vec2 & _cell_size, bool _avoid_sensors)
+{
+    return getEntry(_world_id, _cell_size, _avoid_sensors).grid;
+}
+
+ClusterGraph & OccupancyGridCache::getClusterGraph(
+    b2WorldId _world_id,
+    const b2Vec2 & _cell_size,
+    bool _avoid_sensors,
+    bool _allow_diagonal_steps)
+{
+    Entry & entry = getEntry(_world_id, _cell_size, _avoid_sensors);
+    std::unique_ptr<ClusterGraph> & graph = entry.cluster_graphs[_allow_diagonal_steps ? 1 : 0];
+    if(!graph)
+        graph = std::make_unique<ClusterGraph>(entry.grid, _allow_diagonal_steps);
+    return *graph;
+}
+
+// The snapshot contains the blocked cells of the static shapes only, any other cell is free.
+// Once built, the snapshot is updated by re-rasterizing the invalidated cells only.
+std::shared_ptr<const OccupancySnapshot> OccupancyGridCache::getSnapshot(
+    b2WorldId _world_id,
+    const b2Vec2 & _cell_size,
+    bool _avoid_sensors,
+    const std::function<void(std::vector<b2AABB> &)> & _collect_static_aabbs)
+{
+    Entry & entry = getEntry(_world_id, _cell_size, _avoid_sensors);
+    if(entry.snapshot && entry.snapshot_dirty_rects.empty())
+        return entry.snapshot;
+    OccupancySnapshot::ChunkMap chunks;
+    std::unordered_map<int64_t, OccupancySnapshot::Chunk *> own_chunks;
+    if(entry.snapshot)
+    {
+        chunks = entry.snapshot->getChunks();
+        for(const CellRect & rect : entry.snapshot_dirty_rects)
+            rasterize(entry.grid, rect, chunks, own_chunks);
+    }
+    else
+    {
+        std::vector<b2AABB> aabbs;
+        _collect_static_aabbs(aabbs);
+        for(const b2AABB & aabb : aabbs)
+            rasterize(entry.grid, entry.grid.getCellRect(aabb), chunks, own_chunks);
+    }
+    for(const auto & pair : own_chunks)
+    {
+        if(pair.second->none())
+            chunks.erase(pair.first);
+    }
+    entry.snapshot_dirty_rects.clear();
+    entry.snapshot = std::make_shared<const OccupancySnapshot>(
+        entry.grid.getCellSize(),
+        _avoid_sensors,
+        std::move(chunks));
+    return entry.snapshot;
+}
+
+// Chunks shared with the previous snapshot are copied before the first change
+void OccupancyGridCache::rasterize(
+    OccupancyGrid & _grid,
+    const CellRect & _rect,
+    OccupancySnapshot::ChunkMap & _chunks,
+    std::unordered_map<int64_t, OccupancySnapshot::Chunk *> & _own_chunks)
+{
+    const CellPoint first_chunk = OccupancySnapshot::getChunkOf(CellPoint { .x = _rect.x, .y = _rect.y });
+    const CellPoint last_chunk = OccupancySnapshot::getChunkOf(
+        CellPoint { .x = _rect.x + _rect.w - 1, .y = _rect.y + _rect.h - 1 });
+    for(int32_t chunk_y = first_chunk.y; chunk_y <= last_chunk.y; ++chunk_y)
+    {
+        for(int32_t chunk_x = first_chunk.x; chunk_x <= last_chunk.x; ++chunk_x)
+        {
+            const int64_t chunk_key = OccupancyGrid::makeCellKey(chunk_x, chunk_y);
+            auto [own_it, is_inserted] = _own_chunks.try_emplace(chunk_key, nullptr);
+            if(is_inserted)
+            {
+                std::shared_ptr<const OccupancySnapshot::Chunk> & shared_chunk = _chunks[chunk_key];
+                std::shared_ptr<OccupancySnapshot::Chunk> chunk = shared_chunk
+                    ? std::make_shared<OccupancySnapshot::Chunk>(*shared_chunk)
+                    : std::make_shared<OccupancySnapshot::Chunk>();
+                own_it->second = chunk.get();
+                shared_chunk = std::move(chunk);
+            }
+            const int32_t left = std::max(_rect.x, chunk_x * OccupancySnapshot::chunk_size);
+            const int32_t top = std::max(_rect.y, chunk_y * OccupancySnapshot::chunk_size);
+            const int32_t right = std::min(_rect.x + _rect.w, (chunk_x + 1) * OccupancySnapshot::chunk_size);
+            const int32_t bottom = std::min(_rect.y + _rect.h, (chunk_y + 1) * OccupancySnapshot::chunk_size);
+            for(int32_t y = top; y < bottom; ++y)
+            {
+                for(int32_t x = left; x < right; ++x)
+                {
+                    own_it->second->set(
+                        OccupancySnapshot::getLocalIndex(CellPoint { .x = x, .y = y }),
+                        _grid.isBlocked(x, y));
+                }
+            }
+        }
+    }
+}
+
+void OccupancyGridCache::invalidate()
+{
+    for(Entry & entry : m_entries)
+    {
+        entry.snapshot.reset();
+        entry.snapshot_dirty_rects.clear();
+        entry.grid.invalidate();
+        for(std::unique_ptr<ClusterGraph> & graph : entry.cluster_graphs)
+        {
+            if(graph)
+                graph->invalidate();
+        }
+    }
+}
+
+void OccupancyGridCache::invalidate(const b2AABB & _aabb)
+{
+    for(Entry & entry : m_entries)
+    {
+        const CellRect rect = entry.grid.getCellRect(_aabb);
+        if(entry.snapshot)
+        {
+            // Rebuilding is cheaper than replaying a long list, which also does not grow for unused cell sizes
+            if(entry.snapshot_dirty_rects.size() == s_max_snapshot_dirty_rect_count)
+            {
+                entry.snapshot.reset();
+                entry.snapshot_dirty_rects.clear();
+            }
+            else
+            {
+                entry.snapshot_dirty_rects.push_back(rect);
+            }
+        }
+        entry.grid.invalidate(rect);
+        for(std::unique_ptr<ClusterGraph> & graph : entry.cluster_graphs)
+        {
+            if(graph)
+                graph->invalidate(rect);
+        }
+    }
+}
+
+b2Vec2 OccupancyGridCache::calculateCellSize(b2BodyId _body_id)
+{
+    int shape_count = b2Body_GetShapeCount(_body_id);
+    if(shape_count == 0)
+        return { .x = 1.0f, .y = 1.0f };
+    std::vector<b2ShapeId> shape_ids(shape_count);
+    b2Body_GetShapes(_body_id, shape_ids.data(), shape_count);
+    std::optional<b2AABB> body_aabb;
+    for(int i = 0; i < shape_count; ++i)
+    {
+        if(b2Shape_IsSensor(shape_ids[i]))
+            continue;
+        if(body_aabb.has_value())
+            body_aabb = b2AABB_Union(body_aabb.value(), b2Shape_GetAABB(shape_ids[i]));
+        else
+            body_aabb = b2Shape_GetAABB(shape_ids[i]);
+    }
+    if(!body_aabb.has_value())
+        return { .x = 1.0f, .y = 1.0f };
+    return b2Vec2(
+        std::abs(body_aabb.value().upperBound.x - body_aabb.value().lowerBound.x),
+        std::abs(body_aabb.value().upperBound.y - body_aabb.value().lowerBound.y)
+    );
+}
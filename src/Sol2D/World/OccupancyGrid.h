@@ -0,0 +1,237 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <Sol2D/Def.h>
+#include <Sol2D/World/CellTable.h>
+#include <box2d/box2d.h>
+#include <bitset>
+#include <cmath>
+#include <functional>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Sol2D::World {
+
+class ClusterGraph;
+
+struct CellPoint
+{
+    int32_t x, y;
+
+    bool operator == (const CellPoint &) const = default;
+};
+
+struct CellRect
+{
+    int32_t x, y, w, h;
+
+    bool contains(const CellPoint & _point) const
+    {
+        return _point.x >= x && _point.x < x + w && _point.y >= y && _point.y < y + h;
+    }
+};
+
+// An immutable copy of the blocked cells that can be shared with the worker threads.
+// The cells are stored in square chunks, the chunks untouched by an update are shared between versions.
+class OccupancySnapshot final
+{
+    S2_DISABLE_COPY_AND_MOVE(OccupancySnapshot)
+
+public:
+    static constexpr int32_t chunk_size = 32;
+
+    using Chunk = std::bitset<chunk_size * chunk_size>;
+    using ChunkMap = std::unordered_map<int64_t, std::shared_ptr<const Chunk>>; // By chunk keys
+
+    OccupancySnapshot(const b2Vec2 & _cell_size, bool _avoid_sensors, ChunkMap && _chunks);
+    const b2Vec2 & getCellSize() const;
+    bool doesAvoidSensors() const;
+    bool isBlocked(int32_t _x, int32_t _y) const;
+    const ChunkMap & getChunks() const;
+    static CellPoint getChunkOf(const CellPoint & _cell);
+    static size_t getLocalIndex(const CellPoint & _cell);
+
+private:
+    const b2Vec2 m_cell_size;
+    const bool m_avoid_sensors;
+    const ChunkMap m_chunks;
+};
+
+// Lazily rasterizes static bodies into world-aligned cells.
+// The cell (0, 0) is centered at the origin of the world.
+class OccupancyGrid final
+{
+    S2_DISABLE_COPY_AND_MOVE(OccupancyGrid)
+
+public:
+    OccupancyGrid(b2WorldId _world_id, const b2Vec2 & _cell_size, bool _avoid_sensors);
+    explicit OccupancyGrid(std::shared_ptr<const OccupancySnapshot> _snapshot);
+    const b2Vec2 & getCellSize() const;
+    bool doesAvoidSensors() const;
+    int32_t getCellX(float _x) const;
+    int32_t getCellY(float _y) const;
+    b2Vec2 getCellCenter(int32_t _x, int32_t _y) const;
+    CellRect getCellRect(const b2AABB & _aabb) const;
+    bool isBlocked(int32_t _x, int32_t _y);
+    void invalidate();
+    void invalidate(const CellRect & _rect);
+    static int64_t makeCellKey(int32_t _x, int32_t _y);
+    static CellPoint splitCellKey(int64_t _key);
+
+private:
+    bool queryCell(int32_t _x, int32_t _y) const;
+
+private:
+    b2WorldId m_world_id;
+    std::shared_ptr<const OccupancySnapshot> m_snapshot_ptr;
+    const b2Vec2 m_cell_size;
+    const bool m_avoid_sensors;
+    CellTable<bool> m_cells;
+};
+
+// Keeps grids for the recently used cell sizes.
+// The cache must be invalidated each time a static body is created, destroyed or moved.
+class OccupancyGridCache final
+{
+    S2_DISABLE_COPY_AND_MOVE(OccupancyGridCache)
+
+public:
+    OccupancyGridCache() = default;
+    ~OccupancyGridCache();
+    OccupancyGrid & getGrid(b2WorldId _world_id, const b2Vec2 & _cell_size, bool _avoid_sensors);
+    ClusterGraph & getClusterGraph(
+        b2WorldId _world_id,
+        const b2Vec2 & _cell_size,
+        bool _avoid_sensors,
+        bool _allow_diagonal_steps);
+    std::shared_ptr<const OccupancySnapshot> getSnapshot(
+        b2WorldId _world_id,
+        const b2Vec2 & _cell_size,
+        bool _avoid_sensors,
+        const std::function<void(std::vector<b2AABB> &)> & _collect_static_aabbs);
+    void invalidate();
+    void invalidate(const b2AABB & _aabb);
+    static b2Vec2 calculateCellSize(b2BodyId _body_id);
+
+private:
+    struct Entry
+    {
+        Entry(b2WorldId _world_id, const b2Vec2 & _cell_size, bool _avoid_sensors);
+        ~Entry();
+
+        OccupancyGrid grid;
+        std::unique_ptr<ClusterGraph> cluster_graphs[2]; // By diagonal steps permission
+        std::shared_ptr<const OccupancySnapshot> snapshot;
+        std::vector<CellRect> snapshot_dirty_rects;
+    };
+
+    Entry & getEntry(b2WorldId _world_id, const b2Vec2 & _cell_size, bool _avoid_sensors);
+    static void rasterize(
+        OccupancyGrid & _grid,
+        const CellRect & _rect,
+        OccupancySnapshot::ChunkMap & _chunks,
+        std::unordered_map<int64_t, OccupancySnapshot::Chunk *> & _own_chunks);
+
+private:
+    static constexpr size_t s_max_grid_count = 8;
+    static constexpr size_t s_max_snapshot_dirty_rect_count = 64;
+    std::list<Entry> m_entries;
+};
+
+inline const b2Vec2 & OccupancySnapshot::getCellSize() const
+{
+    return m_cell_size;
+}
+
+inline bool OccupancySnapshot::doesAvoidSensors() const
+{
+    return m_avoid_sensors;
+}
+
+inline const OccupancySnapshot::ChunkMap & OccupancySnapshot::getChunks() const
+{
+    return m_chunks;
+}
+
+inline CellPoint OccupancySnapshot::getChunkOf(const CellPoint & _cell)
+{
+    // Rounding towards negative infinity
+    return CellPoint
+    {
+        .x = _cell.x >= 0 ? _cell.x / chunk_size : (_cell.x - chunk_size + 1) / chunk_size,
+        .y = _cell.y >= 0 ? _cell.y / chunk_size : (_cell.y - chunk_size + 1) / chunk_size
+    };
+}
+
+inline size_t OccupancySnapshot::getLocalIndex(const CellPoint & _cell)
+{
+    const CellPoint chunk = getChunkOf(_cell);
+    return static_cast<size_t>(_cell.y - chunk.y * chunk_size) * chunk_size + (_cell.x - chunk.x * chunk_size);
+}
+
+inline const b2Vec2 & OccupancyGrid::getCellSize() const
+{
+    return m_cell_size;
+}
+
+inline bool OccupancyGrid::doesAvoidSensors() const
+{
+    return m_avoid_sensors;
+}
+
+inline int32_t OccupancyGrid::getCellX(float _x) const
+{
+    return static_cast<int32_t>(std::round(_x / m_cell_size.x));
+}
+
+inline int32_t OccupancyGrid::getCellY(float _y) const
+{
+    return static_cast<int32_t>(std::round(_y / m_cell_size.y));
+}
+
+inline b2Vec2 OccupancyGrid::getCellCenter(int32_t _x, int32_t _y) const
+{
+    return b2Vec2(_x * m_cell_size.x, _y * m_cell_size.y);
+}
+
+inline bool OccupancyGrid::isBlocked(int32_t _x, int32_t _y)
+{
+    auto [is_blocked, is_inserted] = m_cells.tryEmplace(makeCellKey(_x, _y), false);
+    if(is_inserted)
+        *is_blocked = queryCell(_x, _y);
+    return *is_blocked;
+}
+
+inline void OccupancyGrid::invalidate()
+{
+    m_cells.clear();
+}
+
+inline int64_t OccupancyGrid::makeCellKey(int32_t _x, int32_t _y)
+{
+    return (static_cast<int64_t>(_x) << 32) | static_cast<uint32_t>(_y);
+}
+
+inline CellPoint OccupancyGrid::splitCellKey(int64_t _key)
+{
+    return CellPoint { .x = static_cast<int32_t>(_key >> 32), .y = static_cast<int32_t>(static_cast<uint32_t>(_key)) };
+}
+
+} // namespace Sol2D::World
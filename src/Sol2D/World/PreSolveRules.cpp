@@ -0,0 +1,98 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <Sol2D/World/PreSolveRules.h>
+
+using namespace Sol2D::World;
+
+namespace {
+
+// A contact with a one-way shape is kept only if its normal is close to the allowed direction
+constexpr float gc_one_way_min_alignment = 0.7f;
+
+} // namespace
+
+PreSolveRules::PreSolveRules() :
+    m_one_way_normals(1)
+{
+}
+
+uint32_t PreSolveRules::registerTag(const std::string & _tag)
+{
+    auto it = m_tag_ids.find(_tag);
+    if(it != m_tag_ids.end())
+        return it->second;
+    const uint32_t id = static_cast<uint32_t>(m_tag_ids.size() + 1);
+    m_tag_ids.insert(std::make_pair(_tag, id));
+    m_one_way_normals.resize(id + 1);
+    return id;
+}
+
+std::optional<uint32_t> PreSolveRules::findTag(const std::string & _tag) const
+{
+    auto it = m_tag_ids.find(_tag);
+    if(it == m_tag_ids.end())
+        return std::nullopt;
+    return it->second;
+}
+
+void PreSolveRules::setOneWayNormal(const std::string & _tag, const b2Vec2 & _normal)
+{
+    const uint32_t id = registerTag(_tag);
+    m_one_way_normals[id] = b2Normalize(_normal);
+}
+
+bool PreSolveRules::removeOneWayNormal(const std::string & _tag)
+{
+    std::optional<uint32_t> id = findTag(_tag);
+    if(!id.has_value() || !m_one_way_normals[id.value()].has_value())
+        return false;
+    m_one_way_normals[id.value()].reset();
+    return true;
+}
+
+void PreSolveRules::ignoreContacts(const std::string & _tag_a, const std::string & _tag_b)
+{
+    m_ignored_tag_pairs.insert(makeTagPairKey(registerTag(_tag_a), registerTag(_tag_b)));
+}
+
+bool PreSolveRules::restoreContacts(const std::string & _tag_a, const std::string & _tag_b)
+{
+    std::optional<uint32_t> id_a = findTag(_tag_a);
+    std::optional<uint32_t> id_b = findTag(_tag_b);
+    if(!id_a.has_value() || !id_b.has_value())
+        return false;
+    return m_ignored_tag_pairs.erase(makeTagPairKey(id_a.value(), id_b.value())) > 0;
+}
+
+bool PreSolveRules::shouldCollide(uint32_t _tag_id_a, uint32_t _tag_id_b, const b2Manifold & _manifold) const
+{
+    if(_tag_id_a == null_tag_id && _tag_id_b == null_tag_id)
+        return true;
+    if(!m_ignored_tag_pairs.empty() && _tag_id_a != null_tag_id && _tag_id_b != null_tag_id &&
+        m_ignored_tag_pairs.contains(makeTagPairKey(_tag_id_a, _tag_id_b)))
+    {
+        return false;
+    }
+    // The manifold normal points from the shape A to the shape B
+    const std::optional<b2Vec2> & normal_a = m_one_way_normals[_tag_id_a];
+    if(normal_a.has_value() && b2Dot(_manifold.normal, normal_a.value()) < gc_one_way_min_alignment)
+        return false;
+    const std::optional<b2Vec2> & normal_b = m_one_way_normals[_tag_id_b];
+    if(normal_b.has_value() && -b2Dot(_manifold.normal, normal_b.value()) < gc_one_way_min_alignment)
+        return false;
+    return true;
+}
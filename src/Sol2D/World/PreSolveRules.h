@@ -0,0 +1,63 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <Sol2D/Def.h>
+#include <box2d/box2d.h>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Sol2D::World {
+
+// The rules are evaluated inside the Box2D solver, possibly from the worker threads.
+// They must not be modified during a step.
+class PreSolveRules final
+{
+    S2_DISABLE_COPY_AND_MOVE(PreSolveRules)
+
+public:
+    static constexpr uint32_t null_tag_id = 0;
+
+    PreSolveRules();
+    uint32_t registerTag(const std::string & _tag);
+    void setOneWayNormal(const std::string & _tag, const b2Vec2 & _normal);
+    bool removeOneWayNormal(const std::string & _tag);
+    void ignoreContacts(const std::string & _tag_a, const std::string & _tag_b);
+    bool restoreContacts(const std::string & _tag_a, const std::string & _tag_b);
+    bool shouldCollide(uint32_t _tag_id_a, uint32_t _tag_id_b, const b2Manifold & _manifold) const;
+
+private:
+    std::optional<uint32_t> findTag(const std::string & _tag) const;
+    static uint64_t makeTagPairKey(uint32_t _tag_id_a, uint32_t _tag_id_b);
+
+private:
+    std::unordered_map<std::string, uint32_t> m_tag_ids;
+    std::vector<std::optional<b2Vec2>> m_one_way_normals;
+    std::unordered_set<uint64_t> m_ignored_tag_pairs;
+};
+
+inline uint64_t PreSolveRules::makeTagPairKey(uint32_t _tag_id_a, uint32_t _tag_id_b)
+{
+    if(_tag_id_a > _tag_id_b)
+        std::swap(_tag_id_a, _tag_id_b);
+    return (static_cast<uint64_t>(_tag_id_a) << 32) | _tag_id_b;
+}
+
+} // namespace Sol2D::World
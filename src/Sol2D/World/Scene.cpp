@@ -17,8 +17,10 @@
 #include <Sol2D/World/Scene.h>
 #include <Sol2D/World/UserData.h>
 #include <Sol2D/World/AStar.h>
+#include <Sol2D/World/StaticGeometry.h>
 #include <Sol2D/Tiles/Tmx.h>
 #include <Sol2D/Utils/Observable.h>
+#include <Sol2D/Utils/BinaryStream.h>
 #include <unordered_set>
 
 using namespace Sol2D;
@@ -40,7 +42,8 @@ void initBodyPhysics(b2BodyDef & _b2_def, const BodyPhysicsDefinition & _physics
 void initShapePhysics(b2ShapeDef & _b2_shape_def, const BodyShapePhysicsDefinition & _physics)
 {
     _b2_shape_def.isSensor = _physics.is_sensor;
-    _b2_shape_def.enablePreSolveEvents = _physics.is_pre_solve_enabled;
+    // Tagged shapes are subject to the native pre-solve rules
+    _b2_shape_def.enablePreSolveEvents = _physics.is_pre_solve_enabled || _physics.tag.has_value();
     _b2_shape_def.enableContactEvents = true; // TODO: from definition
     if(_physics.density.has_value())
         _b2_shape_def.density = _physics.density.value();
@@ -50,14 +53,309 @@ void initShapePhysics(b2ShapeDef & _b2_shape_def, const BodyShapePhysicsDefiniti
         _b2_shape_def.friction = _physics.friction.value();
 }
 
+b2ShapeId createBox2dShape(b2BodyId _body_id, const b2ShapeDef & _def, const b2Polygon & _polygon)
+{
+    return b2CreatePolygonShape(_body_id, &_def, &_polygon);
+}
+
+b2ShapeId createBox2dShape(b2BodyId _body_id, const b2ShapeDef & _def, const b2Circle & _circle)
+{
+    return b2CreateCircleShape(_body_id, &_def, &_circle);
+}
+
+b2ShapeId createBox2dShape(b2BodyId _body_id, const b2ShapeDef & _def, const b2Capsule & _capsule)
+{
+    return b2CreateCapsuleShape(_body_id, &_def, &_capsule);
+}
+
+constexpr char gc_default_collision_category[] = "default";
+constexpr size_t gc_max_collision_category_count = 32;
+
+std::vector<std::string> splitCollisionCategories(const std::string & _value)
+{
+    std::vector<std::string> names;
+    size_t start = 0;
+    while(start <= _value.size())
+    {
+        size_t end = _value.find(',', start);
+        if(end == std::string::npos)
+            end = _value.size();
+        size_t first = _value.find_first_not_of(' ', start);
+        size_t last = _value.find_last_not_of(' ', end - 1);
+        if(first < end && last != std::string::npos && last >= first)
+            names.emplace_back(_value.substr(first, last - first + 1));
+        start = end + 1;
+    }
+    return names;
+}
+
+// Tiled object properties override the filter defined in the body options
+CollisionFilterDefinition readCollisionFilter(const TileMapObject & _object, const CollisionFilterDefinition & _default)
+{
+    CollisionFilterDefinition filter = _default;
+    if(const std::string * categories = _object.findProperty("collisionCategories"))
+        filter.categories = splitCollisionCategories(*categories);
+    if(const std::string * mask = _object.findProperty("collisionMask"))
+        filter.mask = splitCollisionCategories(*mask);
+    if(const std::string * group = _object.findProperty("collisionGroup"))
+        filter.group = static_cast<int32_t>(std::strtol(group->c_str(), nullptr, 10));
+    return filter;
+}
+
+constexpr int32_t gc_tile_chunk_size = 16;
+
+int32_t getTileChunkIndex(int32_t _tile_index)
+{
+    return _tile_index >= 0 ? _tile_index / gc_tile_chunk_size : (_tile_index + 1) / gc_tile_chunk_size - 1;
+}
+
+uint64_t makeTileChunkKey(int32_t _chunk_x, int32_t _chunk_y)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(_chunk_x)) << 32) | static_cast<uint32_t>(_chunk_y);
+}
+
+// Fewer queries are cheaper to run in the calling thread than to distribute
+constexpr int32_t gc_query_min_range = 32;
+
+template<typename Function>
+void executeQueries(Box2dTaskSystem * _task_system, size_t _count, bool _is_parallel, const Function & _function)
+{
+    if(_is_parallel && _task_system && _count > static_cast<size_t>(gc_query_min_range))
+    {
+        b2TaskCallback * callback = [](int32_t __start, int32_t __end, uint32_t, void * __context) {
+            const Function & function = *static_cast<const Function *>(__context);
+            for(int32_t i = __start; i < __end; ++i)
+                function(static_cast<size_t>(i));
+        };
+        _task_system->execute(
+            callback,
+            static_cast<int32_t>(_count),
+            gc_query_min_range,
+            const_cast<Function *>(&_function));
+        return;
+    }
+    for(size_t i = 0; i < _count; ++i)
+        _function(i);
+}
+
+struct ClosestCastHit
+{
+    static float callback(b2ShapeId _shape_id, b2Vec2 _point, b2Vec2 _normal, float _fraction, void * _context)
+    {
+        if(b2Shape_IsSensor(_shape_id))
+            return -1.0f;
+        // Bodies waiting for destruction are hidden already
+        const Body * body = getUserData(b2Shape_GetBody(_shape_id));
+        if(!body || body->isDestructionPending())
+            return -1.0f;
+        ClosestCastHit * self = static_cast<ClosestCastHit *>(_context);
+        self->shape_id = _shape_id;
+        self->point = _point;
+        self->normal = _normal;
+        self->fraction = _fraction;
+        return _fraction;
+    }
+
+    b2ShapeId shape_id = b2_nullShapeId;
+    b2Vec2 point;
+    b2Vec2 normal;
+    float fraction;
+};
+
+constexpr uint32_t gc_snapshot_magic = 0x4e533253; // S2SN
+constexpr uint16_t gc_snapshot_version = 1;
+constexpr size_t gc_joint_snapshot_value_count = 7;
+
+enum JointSnapshotFlags : uint8_t
+{
+    SpringEnabled = 1 << 0,
+    LimitEnabled = 1 << 1,
+    MotorEnabled = 1 << 2
+};
+
+struct BodySnapshot
+{
+    uint64_t gid;
+    b2Transform transform;
+    b2Vec2 linear_velocity;
+    float angular_velocity;
+    uint8_t is_awake;
+    uint32_t shape_count;
+};
+
+struct BodyShapeSnapshot
+{
+    std::string key;
+    std::string graphics_key;
+    uint64_t frame_index;
+    uint64_t iteration;
+    int64_t frame_elapsed_time;
+};
+
+struct JointSnapshot
+{
+    uint64_t gid;
+    int32_t type;
+    uint8_t flags;
+    float values[gc_joint_snapshot_value_count];
+};
+
+uint8_t makeJointSnapshotFlags(bool _is_spring_enabled, bool _is_limit_enabled, bool _is_motor_enabled)
+{
+    return (_is_spring_enabled ? SpringEnabled : 0) |
+        (_is_limit_enabled ? LimitEnabled : 0) |
+        (_is_motor_enabled ? MotorEnabled : 0);
+}
+
+JointSnapshot captureJointSnapshot(uint64_t _gid, b2JointId _joint_id)
+{
+    JointSnapshot snapshot = { .gid = _gid, .type = static_cast<int32_t>(b2Joint_GetType(_joint_id)), .flags = 0, .values = { } };
+    float * values = snapshot.values;
+    switch(b2Joint_GetType(_joint_id))
+    {
+    case b2_distanceJoint:
+        snapshot.flags = makeJointSnapshotFlags(
+            b2DistanceJoint_IsSpringEnabled(_joint_id),
+            b2DistanceJoint_IsLimitEnabled(_joint_id),
+            b2DistanceJoint_IsMotorEnabled(_joint_id));
+        values[0] = b2DistanceJoint_GetLength(_joint_id);
+        values[1] = b2DistanceJoint_GetMinLength(_joint_id);
+        values[2] = b2DistanceJoint_GetMaxLength(_joint_id);
+        values[3] = b2DistanceJoint_GetSpringHertz(_joint_id);
+        values[4] = b2DistanceJoint_GetSpringDampingRatio(_joint_id);
+        values[5] = b2DistanceJoint_GetMotorSpeed(_joint_id);
+        values[6] = b2DistanceJoint_GetMaxMotorForce(_joint_id);
+        break;
+    case b2_motorJoint:
+    {
+        const b2Vec2 linear_offset = b2MotorJoint_GetLinearOffset(_joint_id);
+        values[0] = linear_offset.x;
+        values[1] = linear_offset.y;
+        values[2] = b2MotorJoint_GetAngularOffset(_joint_id);
+        values[3] = b2MotorJoint_GetMaxForce(_joint_id);
+        values[4] = b2MotorJoint_GetMaxTorque(_joint_id);
+        values[5] = b2MotorJoint_GetCorrectionFactor(_joint_id);
+        break;
+    }
+    case b2_mouseJoint:
+    {
+        const b2Vec2 target = b2MouseJoint_GetTarget(_joint_id);
+        values[0] = target.x;
+        values[1] = target.y;
+        values[2] = b2MouseJoint_GetSpringHertz(_joint_id);
+        values[3] = b2MouseJoint_GetSpringDampingRatio(_joint_id);
+        values[4] = b2MouseJoint_GetMaxForce(_joint_id);
+        break;
+    }
+    case b2_prismaticJoint:
+        snapshot.flags = makeJointSnapshotFlags(
+            b2PrismaticJoint_IsSpringEnabled(_joint_id),
+            b2PrismaticJoint_IsLimitEnabled(_joint_id),
+            b2PrismaticJoint_IsMotorEnabled(_joint_id));
+        values[0] = b2PrismaticJoint_GetLowerLimit(_joint_id);
+        values[1] = b2PrismaticJoint_GetUpperLimit(_joint_id);
+        values[2] = b2PrismaticJoint_GetSpringHertz(_joint_id);
+        values[3] = b2PrismaticJoint_GetSpringDampingRatio(_joint_id);
+        values[4] = b2PrismaticJoint_GetMotorSpeed(_joint_id);
+        values[5] = b2PrismaticJoint_GetMaxMotorForce(_joint_id);
+        break;
+    case b2_weldJoint:
+        values[0] = b2WeldJoint_GetReferenceAngle(_joint_id);
+        values[1] = b2WeldJoint_GetLinearHertz(_joint_id);
+        values[2] = b2WeldJoint_GetLinearDampingRatio(_joint_id);
+        values[3] = b2WeldJoint_GetAngularHertz(_joint_id);
+        values[4] = b2WeldJoint_GetAngularDampingRatio(_joint_id);
+        break;
+    case b2_wheelJoint:
+        snapshot.flags = makeJointSnapshotFlags(
+            b2WheelJoint_IsSpringEnabled(_joint_id),
+            b2WheelJoint_IsLimitEnabled(_joint_id),
+            b2WheelJoint_IsMotorEnabled(_joint_id));
+        values[0] = b2WheelJoint_GetLowerLimit(_joint_id);
+        values[1] = b2WheelJoint_GetUpperLimit(_joint_id);
+        values[2] = b2WheelJoint_GetSpringHertz(_joint_id);
+        values[3] = b2WheelJoint_GetSpringDampingRatio(_joint_id);
+        values[4] = b2WheelJoint_GetMotorSpeed(_joint_id);
+        values[5] = b2WheelJoint_GetMaxMotorTorque(_joint_id);
+        break;
+    default:
+        break;
+    }
+    return snapshot;
+}
+
+void applyJointSnapshot(b2JointId _joint_id, const JointSnapshot & _snapshot)
+{
+    const float * values = _snapshot.values;
+    const bool is_spring_enabled = _snapshot.flags & SpringEnabled;
+    const bool is_limit_enabled = _snapshot.flags & LimitEnabled;
+    const bool is_motor_enabled = _snapshot.flags & MotorEnabled;
+    switch(_snapshot.type)
+    {
+    case b2_distanceJoint:
+        b2DistanceJoint_EnableSpring(_joint_id, is_spring_enabled);
+        b2DistanceJoint_EnableLimit(_joint_id, is_limit_enabled);
+        b2DistanceJoint_EnableMotor(_joint_id, is_motor_enabled);
+        b2DistanceJoint_SetLength(_joint_id, values[0]);
+        b2DistanceJoint_SetLengthRange(_joint_id, values[1], values[2]);
+        b2DistanceJoint_SetSpringHertz(_joint_id, values[3]);
+        b2DistanceJoint_SetSpringDampingRatio(_joint_id, values[4]);
+        b2DistanceJoint_SetMotorSpeed(_joint_id, values[5]);
+        b2DistanceJoint_SetMaxMotorForce(_joint_id, values[6]);
+        break;
+    case b2_motorJoint:
+        b2MotorJoint_SetLinearOffset(_joint_id, b2Vec2 { .x = values[0], .y = values[1] });
+        b2MotorJoint_SetAngularOffset(_joint_id, values[2]);
+        b2MotorJoint_SetMaxForce(_joint_id, values[3]);
+        b2MotorJoint_SetMaxTorque(_joint_id, values[4]);
+        b2MotorJoint_SetCorrectionFactor(_joint_id, values[5]);
+        break;
+    case b2_mouseJoint:
+        b2MouseJoint_SetTarget(_joint_id, b2Vec2 { .x = values[0], .y = values[1] });
+        b2MouseJoint_SetSpringHertz(_joint_id, values[2]);
+        b2MouseJoint_SetSpringDampingRatio(_joint_id, values[3]);
+        b2MouseJoint_SetMaxForce(_joint_id, values[4]);
+        break;
+    case b2_prismaticJoint:
+        b2PrismaticJoint_EnableSpring(_joint_id, is_spring_enabled);
+        b2PrismaticJoint_EnableLimit(_joint_id, is_limit_enabled);
+        b2PrismaticJoint_EnableMotor(_joint_id, is_motor_enabled);
+        b2PrismaticJoint_SetLimits(_joint_id, values[0], values[1]);
+        b2PrismaticJoint_SetSpringHertz(_joint_id, values[2]);
+        b2PrismaticJoint_SetSpringDampingRatio(_joint_id, values[3]);
+        b2PrismaticJoint_SetMotorSpeed(_joint_id, values[4]);
+        b2PrismaticJoint_SetMaxMotorForce(_joint_id, values[5]);
+        break;
+    case b2_weldJoint:
+        b2WeldJoint_SetReferenceAngle(_joint_id, values[0]);
+        b2WeldJoint_SetLinearHertz(_joint_id, values[1]);
+        b2WeldJoint_SetLinearDampingRatio(_joint_id, values[2]);
+        b2WeldJoint_SetAngularHertz(_joint_id, values[3]);
+        b2WeldJoint_SetAngularDampingRatio(_joint_id, values[4]);
+        break;
+    case b2_wheelJoint:
+        b2WheelJoint_EnableSpring(_joint_id, is_spring_enabled);
+        b2WheelJoint_EnableLimit(_joint_id, is_limit_enabled);
+        b2WheelJoint_EnableMotor(_joint_id, is_motor_enabled);
+        b2WheelJoint_SetLimits(_joint_id, values[0], values[1]);
+        b2WheelJoint_SetSpringHertz(_joint_id, values[2]);
+        b2WheelJoint_SetSpringDampingRatio(_joint_id, values[3]);
+        b2WheelJoint_SetMotorSpeed(_joint_id, values[4]);
+        b2WheelJoint_SetMaxMotorTorque(_joint_id, values[5]);
+        break;
+    default:
+        break;
+    }
+}
+
 constexpr SDL_FColor gc_object_debug_color = { .r = 1.0f, .g = .08f, .b = .0f, .a = 1.0f }; // TODO: from config
 
 } // namespace
 
-class Scene::BodyShapeCreator
+class Scene::BodyPrototypeShapeBuilder
 {
 public:
-    explicit BodyShapeCreator(Scene & _scene, Body & _body, const b2BodyId & _b2_body_id, const std::string & _key);
+    BodyPrototypeShapeBuilder(Scene & _scene, const std::string & _key, std::vector<BodyPrototypeShape> & _shapes);
     void operator ()(const BodyPolygonDefinition & _polygon);
     void operator ()(const BodyRectDefinition & _rect);
     void operator ()(const BodyCircleDefinition & _circle);
@@ -65,71 +363,63 @@ public:
 
 private:
     template<BodyShapeType shape_type>
-    b2ShapeDef createBox2dShapeDef(const BodyBasicShapeDefinition<shape_type> & _def) const;
-    template<BodyShapeType shape_type>
-    BodyShape & createShape(const BodyBasicShapeDefinition<shape_type> & _def) const;
+    void addShape(const BodyBasicShapeDefinition<shape_type> & _def, const BodyPrototypeShape::Geometry & _geometry);
 
 private:
     Scene & mr_scene;
-    Body & mr_body;
-    const b2BodyId & mr_b2_body_id;
     const std::string & mr_key;
+    std::vector<BodyPrototypeShape> & mr_shapes;
 };
 
-Scene::BodyShapeCreator::BodyShapeCreator(
+Scene::BodyPrototypeShapeBuilder::BodyPrototypeShapeBuilder(
     Scene & _scene,
-    Body & _body,
-    const b2BodyId & _b2_body_id,
-    const std::string & _key
+    const std::string & _key,
+    std::vector<BodyPrototypeShape> & _shapes
 ) :
     mr_scene(_scene),
-    mr_body(_body),
-    mr_b2_body_id(_b2_body_id),
-    mr_key(_key)
+    mr_key(_key),
+    mr_shapes(_shapes)
 {
 }
 
-void Scene::BodyShapeCreator::operator ()(const BodyPolygonDefinition & _capsule)
+void Scene::BodyPrototypeShapeBuilder::operator ()(const BodyPolygonDefinition & _polygon)
 {
-    if(_capsule.points.size() < 3 || _capsule.points.size() > B2_MAX_POLYGON_VERTICES)
+    if(_polygon.points.size() < 3 || _polygon.points.size() > B2_MAX_POLYGON_VERTICES)
         return; // TODO: log
-    std::vector<b2Vec2> shape_points(_capsule.points.size());
-    for(size_t i = 0; i < _capsule.points.size(); ++i)
+    std::vector<b2Vec2> shape_points(_polygon.points.size());
+    for(size_t i = 0; i < _polygon.points.size(); ++i)
     {
-        shape_points[i].x = mr_scene.graphicalToPhysical(_capsule.points[i].x);
-        shape_points[i].y = mr_scene.graphicalToPhysical(_capsule.points[i].y);
+        shape_points[i].x = mr_scene.graphicalToPhysical(_polygon.points[i].x);
+        shape_points[i].y = mr_scene.graphicalToPhysical(_polygon.points[i].y);
     }
     b2Hull b2_hull = b2ComputeHull(shape_points.data(), shape_points.size());
-    b2Polygon b2_polygon = b2MakePolygon(&b2_hull, .0f);
-    b2ShapeDef b2_shape_def = createBox2dShapeDef(_capsule);
-    b2ShapeId b2_shape_id = b2CreatePolygonShape(mr_b2_body_id, &b2_shape_def, &b2_polygon);
-    BodyShape & body_shape = createShape(_capsule);
-    b2Shape_SetUserData(b2_shape_id, &body_shape);
-}
-
-template<BodyShapeType shape_type>
-inline b2ShapeDef Scene::BodyShapeCreator::createBox2dShapeDef(const BodyBasicShapeDefinition<shape_type> & _def) const
-{
-    b2ShapeDef b2_shape_def = b2DefaultShapeDef();
-    initShapePhysics(b2_shape_def, _def.physics);
-    return b2_shape_def;
+    addShape(_polygon, b2MakePolygon(&b2_hull, .0f));
 }
 
 template<BodyShapeType shape_type>
-BodyShape & Scene::BodyShapeCreator::createShape(const BodyBasicShapeDefinition<shape_type> & _def) const
+void Scene::BodyPrototypeShapeBuilder::addShape(
+    const BodyBasicShapeDefinition<shape_type> & _def,
+    const BodyPrototypeShape::Geometry & _geometry)
 {
-    BodyShape & body_shape = mr_body.createShape(mr_key);
+    BodyPrototypeShape & shape = mr_shapes.emplace_back();
+    shape.key = mr_key;
+    shape.tag = _def.physics.tag;
+    shape.tag_id = mr_scene.registerShapeTag(_def.physics.tag);
+    shape.is_pre_solve_enabled = _def.physics.is_pre_solve_enabled;
+    shape.b2_shape_def = b2DefaultShapeDef();
+    initShapePhysics(shape.b2_shape_def, _def.physics);
+    shape.b2_shape_def.filter = mr_scene.createBox2dFilter(_def.physics.collision_filter);
+    shape.geometry = _geometry;
+    shape.graphics.reserve(_def.graphics.size());
     for(const auto & graphics_kv : _def.graphics)
     {
-        body_shape.addGraphics(
-            mr_scene.mr_renderer,
+        shape.graphics.emplace_back(
             makePreHashedKey(graphics_kv.first),
-            graphics_kv.second);
+            GraphicsPack(mr_scene.mr_renderer, graphics_kv.second));
     }
-    return body_shape;
 }
 
-void Scene::BodyShapeCreator::operator ()(const BodyRectDefinition & _rect)
+void Scene::BodyPrototypeShapeBuilder::operator ()(const BodyRectDefinition & _rect)
 {
     const float half_w = mr_scene.graphicalToPhysical(_rect.w) / 2.0f;
     const float half_h = mr_scene.graphicalToPhysical(_rect.h) / 2.0f;
@@ -141,13 +431,10 @@ void Scene::BodyShapeCreator::operator ()(const BodyRectDefinition & _rect)
             .y = (_rect.y ?  mr_scene.graphicalToPhysical(_rect.y) : .0f) + half_h
         },
         b2Rot_identity);
-    b2ShapeDef b2_shape_def = createBox2dShapeDef(_rect);
-    b2ShapeId b2_shape_id = b2CreatePolygonShape(mr_b2_body_id, &b2_shape_def, &b2_polygon);
-    BodyShape & body_shape = createShape(_rect);
-    b2Shape_SetUserData(b2_shape_id, &body_shape);
+    addShape(_rect, b2_polygon);
 }
 
-void Scene::BodyShapeCreator::operator ()(const BodyCircleDefinition & _circle)
+void Scene::BodyPrototypeShapeBuilder::operator ()(const BodyCircleDefinition & _circle)
 {
     b2Circle b2_circle
     {
@@ -160,13 +447,10 @@ void Scene::BodyShapeCreator::operator ()(const BodyCircleDefinition & _circle)
     };
     if(b2_circle.radius <= .0f)
         return; // TODO: log
-    b2ShapeDef b2_shape_def = createBox2dShapeDef(_circle);
-    b2ShapeId b2_shape_id = b2CreateCircleShape(mr_b2_body_id, &b2_shape_def, &b2_circle);
-    BodyShape & body_shape = createShape(_circle);
-    b2Shape_SetUserData(b2_shape_id, &body_shape);
+    addShape(_circle, b2_circle);
 }
 
-void Scene::BodyShapeCreator::operator ()(const BodyCapsuleShapeDefinition & _capsule)
+void Scene::BodyPrototypeShapeBuilder::operator ()(const BodyCapsuleShapeDefinition & _capsule)
 {
     b2Capsule b2_capsule
     {
@@ -184,10 +468,7 @@ void Scene::BodyShapeCreator::operator ()(const BodyCapsuleShapeDefinition & _ca
     };
     if(b2_capsule.radius <= .0f)
         return; // TODO: log
-    b2ShapeDef b2_shape_def = createBox2dShapeDef(_capsule);
-    b2ShapeId b2_shape_id = b2CreateCapsuleShape(mr_b2_body_id, &b2_shape_def, &b2_capsule);
-    BodyShape & body_shape = createShape(_capsule);
-    b2Shape_SetUserData(b2_shape_id, &body_shape);
+    addShape(_capsule, b2_capsule);
 }
 
 Scene::Scene(const SceneOptions & _options, const Workspace & _workspace, Renderer & _renderer) :
@@ -195,13 +476,28 @@ Scene::Scene(const SceneOptions & _options, const Workspace & _workspace, Render
     mr_renderer(_renderer),
     m_world_offset{.0f, .0f},
     m_meters_per_pixel(_options.meters_per_pixel),
+    m_path_worker_count(_options.path_worker_count),
+    m_path_completion_budget(_options.path_completion_budget),
     m_followed_body_id(b2_nullBodyId),
+    m_has_pre_solve_shapes(false),
     mp_box2d_debug_draw(nullptr)
 {
     if(m_meters_per_pixel <= .0f)
         m_meters_per_pixel = SceneOptions::default_meters_per_pixel;
+    m_collision_categories.insert(std::make_pair(gc_default_collision_category, b2DefaultFilter().categoryBits));
     b2WorldDef world_def = b2DefaultWorldDef();
     world_def.gravity = toBox2D(_options.gravity);
+    uint32_t physics_worker_count = _options.physics_worker_count.has_value()
+        ? _options.physics_worker_count.value()
+        : _workspace.getPhysicsWorkerCount();
+    // 0 means one worker per logical CPU core as in the workspace
+    if(physics_worker_count == 0)
+        physics_worker_count = std::max(1u, std::thread::hardware_concurrency());
+    if(physics_worker_count > 1)
+    {
+        m_box2d_task_system_ptr = std::make_unique<Box2dTaskSystem>(physics_worker_count);
+        m_box2d_task_system_ptr->setup(world_def);
+    }
     m_b2_world_id = b2CreateWorld(&world_def);
     b2World_SetPreSolveCallback(m_b2_world_id, &Scene::box2dPreSolveContact, this);
     if(_workspace.isDebugRenderingEnabled())
@@ -231,10 +527,22 @@ Scene::~Scene()
 void Scene::deinitializeTileMap()
 {
 
-    for(auto it = m_bodies.begin(); it != m_bodies.end(); it = m_bodies.begin())
-        destroyBody(it->first);
-    m_bodies.clear();
+    std::vector<uint64_t> body_ids;
+    body_ids.reserve(m_bodies.getSize());
+    m_bodies.forEach([&body_ids](const Body & __body) {
+        body_ids.push_back(__body.getGid());
+    });
+    m_defers.clear();
+    m_activity_focus_body_ids.clear();
+    m_activity_changes.clear();
+    m_tile_layer_collisions.clear();
+    for(uint64_t body_id : body_ids)
+        destroyBodyImmediately(body_id);
     m_joints.clear();
+    m_layer_bodies.clear();
+    m_unlayered_bodies.clear();
+    m_render_proxies.clear();
+    m_animation_ticker.clear();
     m_tile_heap_ptr.reset();
     m_object_heap_ptr.reset();
     m_tile_map_ptr.reset();
@@ -243,99 +551,489 @@ void Scene::deinitializeTileMap()
 
 void Scene::setGravity(const SDL_FPoint & _vector)
 {
-    m_defers.getQueue().enqueueAction([this, _vector]() {
-        b2World_SetGravity(m_b2_world_id, toBox2D(_vector)); // TODO: scale factor?
-    });
+    m_defers.setGravity(toBox2D(_vector)); // TODO: scale factor?
 }
 
 uint64_t Scene::createBody(const SDL_FPoint & _position, const BodyDefinition & _definition)
+{
+    BodyPrototype prototype(SlotMap<BodyPrototype>::null_handle, createBox2dBodyDef(_definition),
+        createBodyPrototypeShapes(_definition));
+    return createBody(_position, prototype, nullptr);
+}
+
+std::vector<uint64_t> Scene::createBodies(const std::vector<SDL_FPoint> & _positions, const BodyDefinition & _definition)
+{
+    BodyPrototype prototype(SlotMap<BodyPrototype>::null_handle, createBox2dBodyDef(_definition),
+        createBodyPrototypeShapes(_definition));
+    std::vector<uint64_t> body_ids;
+    body_ids.reserve(_positions.size());
+    m_unlayered_bodies.reserve(m_unlayered_bodies.size() + _positions.size());
+    for(const SDL_FPoint & position : _positions)
+        body_ids.push_back(createBody(position, prototype, nullptr));
+    return body_ids;
+}
+
+uint64_t Scene::createBodyPrototype(const std::string & _name, const BodyDefinition & _definition)
+{
+    const BodyPrototype & prototype = m_body_prototypes.emplace(
+        createBox2dBodyDef(_definition),
+        createBodyPrototypeShapes(_definition));
+    auto it = m_body_prototype_ids.find(_name);
+    if(it == m_body_prototype_ids.end())
+    {
+        m_body_prototype_ids.insert(std::make_pair(_name, prototype.getGid()));
+    }
+    else
+    {
+        m_body_prototypes.erase(it->second);
+        it->second = prototype.getGid();
+    }
+    return prototype.getGid();
+}
+
+std::optional<uint64_t> Scene::findBodyPrototype(const std::string & _name) const
+{
+    auto it = m_body_prototype_ids.find(_name);
+    return it == m_body_prototype_ids.end() ? std::nullopt : std::make_optional(it->second);
+}
+
+std::optional<uint64_t> Scene::createBodyFromPrototype(
+    uint64_t _prototype_id,
+    const SDL_FPoint & _position,
+    const BodyPrototypeOverrides & _overrides)
+{
+    const BodyPrototype * prototype = m_body_prototypes.find(_prototype_id);
+    if(!prototype)
+        return std::nullopt;
+    return createBody(_position, *prototype, &_overrides);
+}
+
+b2BodyDef Scene::createBox2dBodyDef(const BodyDefinition & _definition)
 {
     b2BodyDef b2_body_def = b2DefaultBodyDef();
     b2_body_def.type = mapBodyType(_definition.type);
-    b2_body_def.position = { .x = _position.x, .y = _position.y };
     initBodyPhysics(b2_body_def, _definition.physics);
-    b2BodyId b2_body_id = b2CreateBody(m_b2_world_id, &b2_body_def);
-    Body * body = new Body(b2_body_id, m_defers.getQueue());
-    b2Body_SetUserData(b2_body_id, body);
-    m_bodies.insert(std::make_pair(body->getGid(), b2_body_id));
+    return b2_body_def;
+}
+
+std::vector<BodyPrototypeShape> Scene::createBodyPrototypeShapes(const BodyDefinition & _definition)
+{
+    std::vector<BodyPrototypeShape> shapes;
+    shapes.reserve(_definition.shapes.size());
     for(const auto & shape_kv : _definition.shapes)
     {
-        BodyShapeCreator visitor(*this, *body, b2_body_id, shape_kv.first);
-        std::visit(visitor, shape_kv.second);
+        BodyPrototypeShapeBuilder builder(*this, shape_kv.first, shapes);
+        std::visit(builder, shape_kv.second);
     }
-    return body->getGid();
+    return shapes;
+}
+
+uint64_t Scene::createBody(
+    const SDL_FPoint & _position,
+    const BodyPrototype & _prototype,
+    const BodyPrototypeOverrides * _overrides)
+{
+    b2BodyDef b2_body_def = _prototype.getBox2dBodyDef();
+    b2_body_def.position = { .x = _position.x, .y = _position.y };
+    if(_overrides)
+    {
+        if(_overrides->type.has_value())
+            b2_body_def.type = mapBodyType(_overrides->type.value());
+        if(_overrides->linear_velocity.has_value())
+            b2_body_def.linearVelocity = toBox2D(_overrides->linear_velocity.value());
+    }
+    b2BodyId b2_body_id = b2CreateBody(m_b2_world_id, &b2_body_def);
+    Body & body = m_bodies.emplace(b2_body_id, m_defers, m_body_shapes);
+    b2Body_SetUserData(b2_body_id, &body);
+    attachBodyToLayer(b2_body_id, std::nullopt);
+    initRenderProxy(b2_body_id);
+    BodyRenderProxy & proxy = getRenderProxy(b2_body_id);
+    for(const BodyPrototypeShape & prototype_shape : _prototype.getShapes())
+    {
+        b2ShapeId b2_shape_id = std::visit([&](const auto & __geometry) {
+            return createBox2dShape(b2_body_id, prototype_shape.b2_shape_def, __geometry);
+        }, prototype_shape.geometry);
+        BodyShape & body_shape = body.createShape(prototype_shape.key);
+        body_shape.setTag(prototype_shape.tag, prototype_shape.tag_id);
+        body_shape.setPreSolveEnabled(prototype_shape.is_pre_solve_enabled);
+        m_has_pre_solve_shapes |= prototype_shape.is_pre_solve_enabled;
+        for(const auto & graphics_kv : prototype_shape.graphics)
+            body_shape.addGraphics(graphics_kv.first, graphics_kv.second);
+        b2Shape_SetUserData(b2_shape_id, &body_shape);
+        proxy.shapes.push_back(&body_shape);
+    }
+    if(_overrides && _overrides->layer.has_value())
+        setBodyLayer(body.getGid(), _overrides->layer.value());
+    invalidateOccupancy(b2_body_id);
+    return body.getGid();
 }
 
 void Scene::createBodiesFromMapObjects(const std::string & _class, const BodyOptions & _body_options)
 {
     b2BodyType body_type = mapBodyType(_body_options.type);
+    if(body_type == b2_staticBody)
+    {
+        m_occupancy_grids.invalidate(); // Too many bodies to invalidate them one by one
+        invalidateFlowFields();
+    }
+    const uint32_t shape_tag_id = registerShapeTag(_body_options.shape_physics.tag);
+    const bool is_merged = _body_options.is_merged && body_type == b2_staticBody;
+    std::unordered_map<uint32_t, Body *> layer_bodies;
+    std::vector<StaticRect> rects;
+    std::vector<std::pair<Body *, b2Filter>> rect_groups;
+    std::vector<std::pair<uint32_t, std::string>> rect_sources;
     m_object_heap_ptr->forEachObject([&](const TileMapObject & __map_object) {
         if(__map_object.getClass() != _class) return;
         b2BodyDef b2_body_def = b2DefaultBodyDef();
         b2_body_def.type = body_type;
         initBodyPhysics(b2_body_def, _body_options.body_physics);
-        b2_body_def.position =
+        Body * body;
+        SDL_FPoint offset = { .x = .0f, .y = .0f };
+        if(is_merged)
         {
-            .x = graphicalToPhysical(__map_object.getPosition().x),
-            .y = graphicalToPhysical(__map_object.getPosition().y)
-        };
-        b2BodyId b2_body_id = b2CreateBody(m_b2_world_id, &b2_body_def);
-        Body * body = new Body(b2_body_id, m_defers.getQueue());
-        b2Body_SetUserData(b2_body_id, body);
-
-        m_bodies.insert(std::make_pair(body->getGid(), b2_body_id));
+            Body *& layer_body = layer_bodies[__map_object.getLayerId()];
+            if(!layer_body)
+                layer_body = &createMapObjectBody(b2_body_def);
+            body = layer_body;
+            offset = __map_object.getPosition();
+        }
+        else
+        {
+            b2_body_def.position =
+            {
+                .x = graphicalToPhysical(__map_object.getPosition().x),
+                .y = graphicalToPhysical(__map_object.getPosition().y)
+            };
+            body = &createMapObjectBody(b2_body_def);
+        }
         b2ShapeDef b2_shape_def = b2DefaultShapeDef();
         initShapePhysics(b2_shape_def, _body_options.shape_physics);
-
-        const std::string shape_key = _body_options.shape_key.value_or(
+        b2_shape_def.filter = createBox2dFilter(
+            readCollisionFilter(__map_object, _body_options.shape_physics.collision_filter));
+        std::string shape_key = _body_options.shape_key.value_or(
             __map_object.getName().empty() ? _class : __map_object.getName());
-        switch(__map_object.getObjectType())
-        {
-        case TileMapObjectType::Polygon:
+        if(is_merged) // Shape keys must be unique within a body
+            shape_key += "#" + std::to_string(__map_object.getId());
+        if(is_merged && _body_options.merge_rectangles && __map_object.getObjectType() == TileMapObjectType::Polygon)
         {
             const TileMapPolygon * polygon = static_cast<const TileMapPolygon *>(&__map_object);
-            const std::vector<SDL_FPoint> & points = polygon->getPoints();
-            if(points.size() < 3 || points.size() > B2_MAX_POLYGON_VERTICES)
-                break;
-            std::vector<b2Vec2> shape_points(points.size());
-            for(size_t i = 0; i < points.size(); ++i)
+            if(std::optional<SDL_FRect> rect = tryMakeAxisAlignedRect(polygon->getPoints()))
             {
-                shape_points[i].x = graphicalToPhysical(points[i].x);
-                shape_points[i].y = graphicalToPhysical(points[i].y);
+                auto group_it = std::find_if(rect_groups.begin(), rect_groups.end(), [&](const auto & __group) {
+                    return __group.first == body &&
+                        __group.second.categoryBits == b2_shape_def.filter.categoryBits &&
+                        __group.second.maskBits == b2_shape_def.filter.maskBits &&
+                        __group.second.groupIndex == b2_shape_def.filter.groupIndex;
+                });
+                if(group_it == rect_groups.end())
+                    group_it = rect_groups.emplace(rect_groups.end(), body, b2_shape_def.filter);
+                rect.value().x += offset.x;
+                rect.value().y += offset.y;
+                rects.push_back(StaticRect {
+                    .rect = rect.value(),
+                    .group = static_cast<uint32_t>(group_it - rect_groups.begin()),
+                    .source = static_cast<uint32_t>(rect_sources.size())
+                });
+                rect_sources.emplace_back(__map_object.getId(), std::move(shape_key));
+                return;
             }
-            b2Hull b2_hull = b2ComputeHull(shape_points.data(), shape_points.size());
-            b2Polygon b2_polygon = b2MakePolygon(&b2_hull, .0f);
-            b2ShapeId b2_shape_id = b2CreatePolygonShape(b2_body_id, &b2_shape_def, &b2_polygon);
-            BodyShape * body_shape = &body->createShape(shape_key, polygon->getId());
-            b2Shape_SetUserData(b2_shape_id, body_shape);
         }
-        break;
-        case TileMapObjectType::Circle:
+        createMapObjectShape(*body, __map_object, offset, b2_shape_def, shape_key, _body_options, shape_tag_id);
+    });
+    mergeStaticRects(rects);
+    for(const StaticRect & rect : rects)
+    {
+        Body & body = *rect_groups[rect.group].first;
+        const auto & source = rect_sources[rect.source];
+        b2ShapeDef b2_shape_def = b2DefaultShapeDef();
+        initShapePhysics(b2_shape_def, _body_options.shape_physics);
+        b2_shape_def.filter = rect_groups[rect.group].second;
+        b2_shape_def.userData = &createMapObjectBodyShape(
+            body,
+            source.second,
+            source.first,
+            _body_options.shape_physics,
+            shape_tag_id);
+        createStaticRectShape(body.getBox2dId(), b2_shape_def, rect.rect);
+    }
+}
+
+// Tile collision shapes are built into a static body per chunk of the layer
+bool Scene::createBodiesFromTileLayer(const std::string & _layer_name, const BodyOptions & _body_options)
+{
+    const TileMapTileLayer * layer = findTileLayer(_layer_name);
+    if(!layer)
+        return false;
+    TileLayerCollision & collision = m_tile_layer_collisions[layer];
+    for(const auto & pair : collision.chunk_bodies)
+        destroyBody(pair.second);
+    collision.chunk_bodies.clear();
+    collision.body_options = _body_options;
+    collision.shape_tag_id = registerShapeTag(_body_options.shape_physics.tag);
+    if(layer->getWidth() == 0 || layer->getHeight() == 0)
+        return true;
+    const int32_t first_chunk_x = getTileChunkIndex(layer->getX());
+    const int32_t first_chunk_y = getTileChunkIndex(layer->getY());
+    const int32_t last_chunk_x = getTileChunkIndex(layer->getX() + static_cast<int32_t>(layer->getWidth()) - 1);
+    const int32_t last_chunk_y = getTileChunkIndex(layer->getY() + static_cast<int32_t>(layer->getHeight()) - 1);
+    for(int32_t chunk_y = first_chunk_y; chunk_y <= last_chunk_y; ++chunk_y)
+    {
+        for(int32_t chunk_x = first_chunk_x; chunk_x <= last_chunk_x; ++chunk_x)
+            buildTileLayerChunk(*layer, collision, chunk_x, chunk_y);
+    }
+    return true;
+}
+
+bool Scene::setTile(const std::string & _layer_name, int32_t _x, int32_t _y, uint32_t _gid)
+{
+    TileMapTileLayer * layer = findTileLayer(_layer_name);
+    if(!layer || !layer->getCell(_x, _y) || !m_tile_heap_ptr->getTile(_gid))
+        return false;
+    layer->setTile(_x, _y, _gid);
+    rebuildTileLayerChunk(*layer, _x, _y);
+    return true;
+}
+
+bool Scene::eraseTile(const std::string & _layer_name, int32_t _x, int32_t _y)
+{
+    TileMapTileLayer * layer = findTileLayer(_layer_name);
+    if(!layer || !layer->eraseTile(_x, _y))
+        return false;
+    rebuildTileLayerChunk(*layer, _x, _y);
+    return true;
+}
+
+TileMapTileLayer * Scene::findTileLayer(const std::string & _layer_name)
+{
+    if(!m_tile_map_ptr)
+        return nullptr;
+    TileMapLayer * layer = m_tile_map_ptr->getLayer(_layer_name);
+    if(!layer || layer->getType() != TileMapLayerType::Tile)
+        return nullptr;
+    return static_cast<TileMapTileLayer *>(layer);
+}
+
+void Scene::rebuildTileLayerChunk(const TileMapTileLayer & _layer, int32_t _x, int32_t _y)
+{
+    auto it = m_tile_layer_collisions.find(&_layer);
+    if(it != m_tile_layer_collisions.end())
+        buildTileLayerChunk(_layer, it->second, getTileChunkIndex(_x), getTileChunkIndex(_y));
+}
+
+void Scene::buildTileLayerChunk(
+    const TileMapTileLayer & _layer,
+    TileLayerCollision & _collision,
+    int32_t _chunk_x,
+    int32_t _chunk_y)
+{
+    const uint64_t chunk_key = makeTileChunkKey(_chunk_x, _chunk_y);
+    if(auto it = _collision.chunk_bodies.find(chunk_key); it != _collision.chunk_bodies.end())
+    {
+        destroyBody(it->second);
+        _collision.chunk_bodies.erase(it);
+    }
+    const float tile_width = static_cast<float>(m_tile_map_ptr->getTileWidth());
+    const float tile_height = static_cast<float>(m_tile_map_ptr->getTileHeight());
+    SDL_FPoint layer_offset { .x = _layer.getOffsetX(), .y = _layer.getOffsetY() };
+    for(const auto * parent_layer = _layer.getParent(); parent_layer; parent_layer = parent_layer->getParent())
+    {
+        layer_offset.x += parent_layer->getOffsetX();
+        layer_offset.y += parent_layer->getOffsetY();
+    }
+    std::vector<StaticRect> rects;
+    std::vector<std::vector<b2Vec2>> polygons;
+    for(int32_t row = _chunk_y * gc_tile_chunk_size; row < (_chunk_y + 1) * gc_tile_chunk_size; ++row)
+    {
+        for(int32_t col = _chunk_x * gc_tile_chunk_size; col < (_chunk_x + 1) * gc_tile_chunk_size; ++col)
         {
-            const TileMapCircle * circle = static_cast<const TileMapCircle *>(&__map_object);
-            const float radius = graphicalToPhysical(circle->getRadius());
-            if(radius <= .0f)
-                break;
-            b2Circle b2_circle
+            const TileMapTileLayerCell * cell = _layer.getCell(col, row);
+            if(!cell || !cell->tile || cell->tile->getCollisionShapes().empty())
+                continue;
+            // Tiles are aligned to the bottom of the cell
+            const SDL_FPoint origin
             {
-                .center = { .x = .0f, .y = .0f },
-                .radius = radius
+                .x = layer_offset.x + col * tile_width,
+                .y = layer_offset.y + (row + 1) * tile_height - cell->tile->getHeight()
             };
-            b2ShapeId b2_shape_id = b2CreateCircleShape(b2_body_id, &b2_shape_def, &b2_circle);
-            BodyShape * body_shape = &body->createShape(shape_key, circle->getId());
-            b2Shape_SetUserData(b2_shape_id, body_shape);
+            for(const TileCollisionShape & shape : cell->tile->getCollisionShapes())
+            {
+                if(std::optional<SDL_FRect> rect = tryMakeAxisAlignedRect(shape.points))
+                {
+                    rect.value().x += origin.x;
+                    rect.value().y += origin.y;
+                    rects.push_back(StaticRect { .rect = rect.value(), .group = 0, .source = 0 });
+                    continue;
+                }
+                std::vector<b2Vec2> & points = polygons.emplace_back(shape.points.size());
+                for(size_t i = 0; i < shape.points.size(); ++i)
+                {
+                    points[i].x = graphicalToPhysical(origin.x + shape.points[i].x);
+                    points[i].y = graphicalToPhysical(origin.y + shape.points[i].y);
+                }
+            }
         }
-        break;
-        default: return;
+    }
+    if(rects.empty() && polygons.empty())
+        return;
+    mergeStaticRects(rects);
+    const BodyOptions & options = _collision.body_options;
+    b2BodyDef b2_body_def = b2DefaultBodyDef();
+    b2_body_def.type = b2_staticBody;
+    initBodyPhysics(b2_body_def, options.body_physics);
+    Body & body = createMapObjectBody(b2_body_def);
+    b2ShapeDef b2_shape_def = b2DefaultShapeDef();
+    initShapePhysics(b2_shape_def, options.shape_physics);
+    b2_shape_def.filter = createBox2dFilter(options.shape_physics.collision_filter);
+    b2_shape_def.userData = &createMapObjectBodyShape(
+        body,
+        options.shape_key.value_or(_layer.getName()),
+        std::nullopt,
+        options.shape_physics,
+        _collision.shape_tag_id);
+    for(const StaticRect & rect : rects)
+        createStaticRectShape(body.getBox2dId(), b2_shape_def, rect.rect);
+    for(std::vector<b2Vec2> & points : polygons)
+    {
+        if(points.size() <= B2_MAX_POLYGON_VERTICES)
+        {
+            b2Hull b2_hull = b2ComputeHull(points.data(), points.size());
+            b2Polygon b2_polygon = b2MakePolygon(&b2_hull, .0f);
+            b2CreatePolygonShape(body.getBox2dId(), &b2_shape_def, &b2_polygon);
         }
-    });
+        else
+        {
+            createStaticChain(body.getBox2dId(), b2_shape_def, points, true);
+        }
+    }
+    invalidateOccupancy(body.getBox2dId());
+    _collision.chunk_bodies.emplace(chunk_key, body.getGid());
+}
+
+void Scene::createStaticRectShape(b2BodyId _body_id, const b2ShapeDef & _b2_shape_def, const SDL_FRect & _rect)
+{
+    const b2Vec2 points[] =
+    {
+        { .x = graphicalToPhysical(_rect.x), .y = graphicalToPhysical(_rect.y) },
+        { .x = graphicalToPhysical(_rect.x + _rect.w), .y = graphicalToPhysical(_rect.y) },
+        { .x = graphicalToPhysical(_rect.x + _rect.w), .y = graphicalToPhysical(_rect.y + _rect.h) },
+        { .x = graphicalToPhysical(_rect.x), .y = graphicalToPhysical(_rect.y + _rect.h) }
+    };
+    b2Hull b2_hull = b2ComputeHull(points, 4);
+    b2Polygon b2_polygon = b2MakePolygon(&b2_hull, .0f);
+    b2CreatePolygonShape(_body_id, &_b2_shape_def, &b2_polygon);
+}
+
+Body & Scene::createMapObjectBody(const b2BodyDef & _b2_body_def)
+{
+    b2BodyId b2_body_id = b2CreateBody(m_b2_world_id, &_b2_body_def);
+    Body & body = m_bodies.emplace(b2_body_id, m_defers, m_body_shapes);
+    b2Body_SetUserData(b2_body_id, &body);
+    attachBodyToLayer(b2_body_id, std::nullopt);
+    initRenderProxy(b2_body_id);
+    return body;
+}
+
+BodyShape & Scene::createMapObjectBodyShape(
+    Body & _body,
+    const std::string & _key,
+    std::optional<uint32_t> _tile_map_object_id,
+    const BodyShapePhysicsDefinition & _physics,
+    uint32_t _tag_id)
+{
+    BodyShape & body_shape = _body.createShape(_key, _tile_map_object_id);
+    body_shape.setTag(_physics.tag, _tag_id);
+    body_shape.setPreSolveEnabled(_physics.is_pre_solve_enabled);
+    m_has_pre_solve_shapes |= _physics.is_pre_solve_enabled;
+    getRenderProxy(_body.getBox2dId()).shapes.push_back(&body_shape);
+    return body_shape;
+}
+
+// The offset is the position of the object relative to the body
+void Scene::createMapObjectShape(
+    Body & _body,
+    const TileMapObject & _map_object,
+    const SDL_FPoint & _offset,
+    b2ShapeDef & _b2_shape_def,
+    const std::string & _shape_key,
+    const BodyOptions & _body_options,
+    uint32_t _tag_id)
+{
+    const b2BodyId b2_body_id = _body.getBox2dId();
+    switch(_map_object.getObjectType())
+    {
+    case TileMapObjectType::Polygon:
+    case TileMapObjectType::Polyline:
+    {
+        const std::vector<SDL_FPoint> & points = static_cast<const TileMapPolyX *>(&_map_object)->getPoints();
+        const bool is_polygon = _map_object.getObjectType() == TileMapObjectType::Polygon;
+        if(points.size() < (is_polygon ? 3 : 2))
+            break;
+        std::vector<b2Vec2> shape_points(points.size());
+        for(size_t i = 0; i < points.size(); ++i)
+        {
+            shape_points[i].x = graphicalToPhysical(_offset.x + points[i].x);
+            shape_points[i].y = graphicalToPhysical(_offset.y + points[i].y);
+        }
+        _b2_shape_def.userData = &createMapObjectBodyShape(
+            _body,
+            _shape_key,
+            _map_object.getId(),
+            _body_options.shape_physics,
+            _tag_id);
+        // Polygons that have too many vertices to be convex Box2D polygons are approximated by their outlines
+        if(is_polygon && !_body_options.use_chain_outlines && points.size() <= B2_MAX_POLYGON_VERTICES)
+        {
+            b2Hull b2_hull = b2ComputeHull(shape_points.data(), shape_points.size());
+            b2Polygon b2_polygon = b2MakePolygon(&b2_hull, .0f);
+            b2CreatePolygonShape(b2_body_id, &_b2_shape_def, &b2_polygon);
+        }
+        else
+        {
+            createStaticChain(b2_body_id, _b2_shape_def, shape_points, is_polygon);
+        }
+    }
+    break;
+    case TileMapObjectType::Circle:
+    {
+        const TileMapCircle * circle = static_cast<const TileMapCircle *>(&_map_object);
+        const float radius = graphicalToPhysical(circle->getRadius());
+        if(radius <= .0f)
+            break;
+        b2Circle b2_circle
+        {
+            .center = { .x = graphicalToPhysical(_offset.x), .y = graphicalToPhysical(_offset.y) },
+            .radius = radius
+        };
+        _b2_shape_def.userData = &createMapObjectBodyShape(
+            _body,
+            _shape_key,
+            circle->getId(),
+            _body_options.shape_physics,
+            _tag_id);
+        b2CreateCircleShape(b2_body_id, &_b2_shape_def, &b2_circle);
+    }
+    break;
+    default: break;
+    }
 }
 
+// The body is hidden immediately, but Box2D structures are changed in the next step
 bool Scene::destroyBody(uint64_t _body_id)
 {
-    b2BodyId b2_body_id = findBox2dBody(_body_id);
-    if(B2_IS_NULL(b2_body_id))
+    Body * body = getBody(_body_id);
+    if(!body)
+        return false;
+    body->markForDestruction();
+    m_defers.destroyBody(_body_id);
+    return true;
+}
+
+bool Scene::destroyBodyImmediately(uint64_t _body_id)
+{
+    Body * body = m_bodies.find(_body_id);
+    if(!body)
          return false;
+    b2BodyId b2_body_id = body->getBox2dId();
     if(B2_ID_EQUALS(m_followed_body_id, b2_body_id))
         m_followed_body_id = b2_nullBodyId;
     if(int joints_count = b2Body_GetJointCount(b2_body_id))
@@ -345,55 +1043,344 @@ bool Scene::destroyBody(uint64_t _body_id)
         for(const b2JointId & b2_joint_id : b2_joints)
             destroyJoint(getUserData(b2_joint_id)->getGid());
     }
-    delete getUserData(b2_body_id);
-    b2DestroyBody(b2_body_id);
+    invalidateOccupancy(b2_body_id);
+    detachBodyFromLayer(b2_body_id, body->getLayer());
+    for(const BodyShape * shape : getRenderProxy(b2_body_id).shapes)
+        m_animation_ticker.detach(*shape);
+    releaseRenderProxy(b2_body_id);
     m_bodies.erase(_body_id);
+    b2DestroyBody(b2_body_id);
     return true;
 }
 
+void Scene::invalidateOccupancy(b2BodyId _body_id)
+{
+    if(b2Body_GetType(_body_id) != b2_staticBody)
+        return;
+    const int shape_count = b2Body_GetShapeCount(_body_id);
+    if(shape_count == 0)
+        return;
+    std::vector<b2ShapeId> shape_ids(shape_count);
+    b2Body_GetShapes(_body_id, shape_ids.data(), shape_count);
+    b2AABB aabb = b2Shape_GetAABB(shape_ids[0]);
+    for(int i = 1; i < shape_count; ++i)
+        aabb = b2AABB_Union(aabb, b2Shape_GetAABB(shape_ids[i]));
+    m_occupancy_grids.invalidate(aabb);
+    invalidateFlowFields();
+}
+
 Body * Scene::getBody(uint64_t _body_id)
 {
-    auto it = m_bodies.find(_body_id);
-    return it == m_bodies.end() ? nullptr : getUserData(it->second);
+    Body * body = m_bodies.find(_body_id);
+    return body && !body->isDestructionPending() ? body : nullptr;
 }
 
 b2BodyId Scene::findBox2dBody(uint64_t _body_id) const
 {
-    auto it = m_bodies.find(_body_id);
-    return it == m_bodies.end() ? b2_nullBodyId : it->second;
+    const Body * body = m_bodies.find(_body_id);
+    return body && !body->isDestructionPending() ? body->getBox2dId() : b2_nullBodyId;
+}
+
+b2BodyType Scene::mapBodyType(BodyType _type)
+{
+    switch(_type)
+    {
+    case BodyType::Dynamic:
+        return b2_dynamicBody;
+    case BodyType::Kinematic:
+        return b2_kinematicBody;
+    default:
+        return b2_staticBody;
+    }
+}
+
+bool Scene::declareCollisionCategory(const std::string & _name)
+{
+    if(m_collision_categories.size() >= gc_max_collision_category_count || m_collision_categories.contains(_name))
+        return false;
+    uint32_t bits = 0;
+    for(const auto & category : m_collision_categories)
+        bits |= category.second;
+    for(uint32_t bit = 1; bit != 0; bit <<= 1)
+    {
+        if((bits & bit) == 0)
+        {
+            m_collision_categories.insert(std::make_pair(_name, bit));
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t Scene::getCollisionCategoryBits(const std::vector<std::string> & _names) const
+{
+    uint32_t bits = 0;
+    for(const std::string & name : _names)
+    {
+        auto it = m_collision_categories.find(name);
+        if(it == m_collision_categories.end())
+            mr_workspace.getMainLogger().warn("Collision category \"{}\" is not declared", name);
+        else
+            bits |= it->second;
+    }
+    return bits;
+}
+
+b2Filter Scene::createBox2dFilter(const CollisionFilterDefinition & _definition) const
+{
+    b2Filter filter = b2DefaultFilter();
+    if(!_definition.categories.empty())
+        filter.categoryBits = getCollisionCategoryBits(_definition.categories);
+    if(_definition.mask.has_value())
+        filter.maskBits = getCollisionCategoryBits(_definition.mask.value());
+    if(_definition.group.has_value())
+        filter.groupIndex = _definition.group.value();
+    return filter;
+}
+
+uint32_t Scene::registerShapeTag(const std::optional<std::string> & _tag)
+{
+    return _tag.has_value() ? m_pre_solve_rules.registerTag(_tag.value()) : PreSolveRules::null_tag_id;
+}
+
+void Scene::setOneWayNormal(const std::string & _tag, const SDL_FPoint & _normal)
+{
+    m_pre_solve_rules.setOneWayNormal(_tag, toBox2D(_normal));
+}
+
+bool Scene::removeOneWayNormal(const std::string & _tag)
+{
+    return m_pre_solve_rules.removeOneWayNormal(_tag);
+}
+
+void Scene::ignoreTagContacts(const std::string & _tag_a, const std::string & _tag_b)
+{
+    m_pre_solve_rules.ignoreContacts(_tag_a, _tag_b);
+}
+
+bool Scene::restoreTagContacts(const std::string & _tag_a, const std::string & _tag_b)
+{
+    return m_pre_solve_rules.restoreContacts(_tag_a, _tag_b);
+}
+
+bool Scene::setFollowedBody(uint64_t _body_id)
+{
+    m_followed_body_id = findBox2dBody(_body_id);
+    return B2_IS_NON_NULL(m_followed_body_id);
+}
+
+void Scene::resetFollowedBody()
+{
+    m_followed_body_id = b2_nullBodyId;
+}
+
+bool Scene::setBodyLayer(uint64_t _body_id, const std::string & _layer)
+{
+    b2BodyId b2_body_id = findBox2dBody(_body_id);
+    if(B2_IS_NULL(b2_body_id))
+        return false;
+    Body * body = getUserData(b2_body_id);
+    if(body->getLayer() == _layer)
+        return true;
+    detachBodyFromLayer(b2_body_id, body->getLayer());
+    body->setLayer(_layer);
+    attachBodyToLayer(b2_body_id, _layer);
+    return true;
+}
+
+bool Scene::setBodyPosition(uint64_t _body_id, const SDL_FPoint & _position)
+{
+    if(!getBody(_body_id))
+        return false;
+    m_defers.setBodyPosition(_body_id, toBox2D(_position));
+    return true;
+}
+
+void Scene::setActivityRegion(const ActivityRegionOptions & _options)
+{
+    m_activity_region = _options;
+}
+
+void Scene::resetActivityRegion()
+{
+    m_activity_region.reset();
+    m_bodies.forEach([this](const Body & __body) {
+        const b2BodyId b2_body_id = __body.getBox2dId();
+        if(!b2Body_IsEnabled(b2_body_id))
+        {
+            b2Body_Enable(b2_body_id);
+            m_activity_changes.emplace_back(__body.getGid(), true);
+        }
+    });
+}
+
+bool Scene::addActivityFocus(uint64_t _body_id)
+{
+    if(!getBody(_body_id))
+        return false;
+    m_activity_focus_body_ids.insert(_body_id);
+    return true;
+}
+
+bool Scene::removeActivityFocus(uint64_t _body_id)
+{
+    return m_activity_focus_body_ids.erase(_body_id) > 0;
+}
+
+std::optional<bool> Scene::isBodyActive(uint64_t _body_id) const
+{
+    const b2BodyId b2_body_id = findBox2dBody(_body_id);
+    if(B2_IS_NULL(b2_body_id))
+        return std::nullopt;
+    return b2Body_IsEnabled(b2_body_id);
+}
+
+// Static bodies are never disabled: they are cheap to keep and the path finding queries rely on them
+void Scene::updateActivityRegion()
+{
+    if(!m_activity_region.has_value())
+        return;
+    const ActivityRegionOptions & options = m_activity_region.value();
+    const FSize output_size = mr_renderer.getOutputSize();
+    m_activity_rects.clear();
+    m_activity_rects.push_back(SDL_FRect {
+        .x = m_world_offset.x - options.camera_margin,
+        .y = m_world_offset.y - options.camera_margin,
+        .w = output_size.w + options.camera_margin * 2,
+        .h = output_size.h + options.camera_margin * 2
+    });
+    for(auto it = m_activity_focus_body_ids.begin(); it != m_activity_focus_body_ids.end();)
+    {
+        const b2BodyId b2_body_id = findBox2dBody(*it);
+        if(B2_IS_NULL(b2_body_id))
+        {
+            it = m_activity_focus_body_ids.erase(it);
+            continue;
+        }
+        const b2Vec2 position = b2Body_GetPosition(b2_body_id);
+        m_activity_rects.push_back(SDL_FRect {
+            .x = physicalToGraphical(position.x) - options.focus_radius,
+            .y = physicalToGraphical(position.y) - options.focus_radius,
+            .w = options.focus_radius * 2,
+            .h = options.focus_radius * 2
+        });
+        ++it;
+    }
+    m_bodies.forEach([this, &options](const Body & __body) {
+        const b2BodyId b2_body_id = __body.getBox2dId();
+        if(b2Body_GetType(b2_body_id) == b2_staticBody)
+            return;
+        const bool is_enabled = b2Body_IsEnabled(b2_body_id);
+        const float distance = is_enabled ? options.hysteresis : .0f;
+        const b2Vec2 position = b2Body_GetPosition(b2_body_id);
+        const float x = physicalToGraphical(position.x);
+        const float y = physicalToGraphical(position.y);
+        const bool is_inside = std::any_of(m_activity_rects.cbegin(), m_activity_rects.cend(),
+            [x, y, distance](const SDL_FRect & __rect) {
+                return x >= __rect.x - distance && x <= __rect.x + __rect.w + distance &&
+                    y >= __rect.y - distance && y <= __rect.y + __rect.h + distance;
+            });
+        if(is_enabled && !is_inside)
+        {
+            b2Body_Disable(b2_body_id);
+            m_activity_changes.emplace_back(__body.getGid(), false);
+        }
+        else if(!is_enabled && is_inside)
+        {
+            b2Body_Enable(b2_body_id);
+            m_activity_changes.emplace_back(__body.getGid(), true);
+        }
+    });
 }
 
-b2BodyType Scene::mapBodyType(BodyType _type)
+// The observers are called outside of the body iteration because they may create bodies
+void Scene::notifyActivityChanges()
 {
-    switch(_type)
+    if(m_activity_changes.empty())
+        return;
+    if(Observable<BodyActivityObserver>::hasObservers())
     {
-    case BodyType::Dynamic:
-        return b2_dynamicBody;
-    case BodyType::Kinematic:
-        return b2_kinematicBody;
-    default:
-        return b2_staticBody;
+        // The observers may reset the region and add changes
+        for(size_t i = 0; i < m_activity_changes.size(); ++i)
+        {
+            const std::pair<uint64_t, bool> change = m_activity_changes[i];
+            Observable<BodyActivityObserver>::callObservers(
+                &BodyActivityObserver::onBodyActivityChanged,
+                change.first,
+                change.second);
+        }
     }
+    m_activity_changes.clear();
 }
 
-bool Scene::setFollowedBody(uint64_t _body_id)
+// Structural changes go first, the actions of the destroyed bodies are skipped
+void Scene::executeActions()
 {
-    m_followed_body_id = findBox2dBody(_body_id);
-    return B2_IS_NON_NULL(m_followed_body_id);
+    m_defers.execute(
+        [this](uint64_t __body_id)
+        {
+            destroyBodyImmediately(__body_id);
+        },
+        [this](const Action & __action)
+        {
+            if(__action.type == ActionType::SetGravity)
+            {
+                b2World_SetGravity(m_b2_world_id, __action.vector);
+                return;
+            }
+            const b2BodyId b2_body_id = findBox2dBody(__action.body_id);
+            if(B2_IS_NULL(b2_body_id))
+                return;
+            switch(__action.type)
+            {
+            case ActionType::SetBodyPosition:
+                invalidateOccupancy(b2_body_id);
+                b2Body_SetTransform(b2_body_id, __action.vector, b2Body_GetRotation(b2_body_id));
+                invalidateOccupancy(b2_body_id);
+                // Box2D does not report teleports of static and sleeping bodies as move events
+                updateRenderProxy(getRenderProxy(b2_body_id), b2Body_GetTransform(b2_body_id));
+                break;
+            case ActionType::ApplyForceToCenter:
+                b2Body_ApplyForceToCenter(b2_body_id, __action.vector, true);
+                break;
+            case ActionType::ApplyImpulseToCenter:
+                b2Body_ApplyLinearImpulseToCenter(b2_body_id, __action.vector, true);
+                break;
+            default:
+                break;
+            }
+        });
 }
 
-void Scene::resetFollowedBody()
+void Scene::attachBodyToLayer(b2BodyId _body_id, const std::optional<std::string> & _layer)
 {
-    m_followed_body_id = b2_nullBodyId;
+    std::vector<b2BodyId> & bodies = _layer.has_value() ? m_layer_bodies[_layer.value()].bodies : m_unlayered_bodies;
+    getUserData(_body_id)->setLayerIndex(bodies.size());
+    bodies.push_back(_body_id);
 }
 
-bool Scene::setBodyLayer(uint64_t _body_id, const std::string & _layer)
+void Scene::detachBodyFromLayer(b2BodyId _body_id, const std::optional<std::string> & _layer)
 {
-    b2BodyId b2_body_id = findBox2dBody(_body_id);
-    if(B2_IS_NULL(b2_body_id))
-        return false;
-    getUserData(b2_body_id)->setLayer(_layer);
-    return true;
+    auto layer_it = m_layer_bodies.end();
+    std::vector<b2BodyId> * bodies = &m_unlayered_bodies;
+    if(_layer.has_value())
+    {
+        layer_it = m_layer_bodies.find(_layer.value());
+        if(layer_it == m_layer_bodies.end())
+            return;
+        bodies = &layer_it->second.bodies;
+    }
+    const size_t index = getUserData(_body_id)->getLayerIndex();
+    if(index >= bodies->size() || !B2_ID_EQUALS((*bodies)[index], _body_id))
+        return;
+    if(index + 1 != bodies->size())
+    {
+        (*bodies)[index] = bodies->back();
+        getUserData((*bodies)[index])->setLayerIndex(index);
+    }
+    bodies->pop_back();
+    if(bodies->empty() && layer_it != m_layer_bodies.end())
+        m_layer_bodies.erase(layer_it);
 }
 
 GraphicsPack * Scene::getBodyShapeGraphicsPack(
@@ -407,7 +1394,10 @@ GraphicsPack * Scene::getBodyShapeGraphicsPack(
     BodyShape * shape = getUserData(b2_body_id)->findShape(_shape_key);
     if(shape == nullptr)
         return nullptr;
-    return shape->getGraphics(_graphics_key);
+    GraphicsPack * graphics = shape->getGraphics(_graphics_key);
+    if(graphics && graphics == shape->getCurrentGraphics())
+        m_animation_ticker.sync(*shape);
+    return graphics;
 }
 
 GraphicsPack * Scene::getBodyShapeCurrentGraphics(uint64_t _body_id, const PreHashedKey<std::string> & _shape_key)
@@ -418,6 +1408,7 @@ GraphicsPack * Scene::getBodyShapeCurrentGraphics(uint64_t _body_id, const PreHa
     BodyShape * shape = getUserData(b2_body_id)->findShape(_shape_key);
     if(shape == nullptr)
         return nullptr;
+    m_animation_ticker.sync(*shape);
     return shape->getCurrentGraphics();
 }
 
@@ -432,7 +1423,10 @@ bool Scene::setBodyShapeCurrentGraphics(
     BodyShape * shape = getUserData(b2_body_id)->findShape(_shape_key);
     if(shape == nullptr)
         return false;
-    return shape->setCurrentGraphics(_graphic_key);
+    if(!shape->setCurrentGraphics(_graphic_key))
+        return false;
+    m_animation_ticker.attach(_body_id, *shape);
+    return true;
 }
 
 bool Scene::flipBodyShapeGraphics(
@@ -776,6 +1770,154 @@ b2JointId Scene::findJoint(uint64_t _joint_id) const
     return it == m_joints.cend() ? b2_nullJointId : it->second;
 }
 
+std::vector<uint8_t> Scene::snapshot()
+{
+    std::vector<uint8_t> buffer;
+    BinaryWriter writer(buffer);
+    writer.write(gc_snapshot_magic);
+    writer.write(gc_snapshot_version);
+    writer.write(b2World_GetGravity(m_b2_world_id));
+
+    const size_t body_count_offset = writer.getOffset();
+    uint32_t body_count = 0;
+    writer.write(body_count);
+    m_bodies.forEach([this, &writer, &body_count](Body & __body) {
+        if(__body.isDestructionPending())
+            return;
+        const b2BodyId b2_body_id = __body.getBox2dId();
+        writer.write(__body.getGid());
+        writer.write(b2Body_GetTransform(b2_body_id));
+        writer.write(b2Body_GetLinearVelocity(b2_body_id));
+        writer.write(b2Body_GetAngularVelocity(b2_body_id));
+        writer.write(static_cast<uint8_t>(b2Body_IsAwake(b2_body_id)));
+        // Only shapes with graphics have a playback state, merged map bodies can have thousands of bare shapes
+        const size_t shape_count_offset = writer.getOffset();
+        uint32_t shape_count = 0;
+        writer.write(shape_count);
+        __body.forEachShape([this, &writer, &shape_count](BodyShape & __shape) {
+            std::optional<PreHashedKey<std::string>> graphics_key = __shape.getCurrentGraphicsKey();
+            if(!graphics_key.has_value())
+                return;
+            m_animation_ticker.sync(__shape);
+            const GraphicsPack * graphics = __shape.getCurrentGraphics();
+            writer.writeString(__shape.getKey());
+            writer.writeString(graphics_key.value().key);
+            writer.write(static_cast<uint64_t>(graphics->getCurrentFrameIndex()));
+            writer.write(static_cast<uint64_t>(graphics->getCurrentAnimationIteration()));
+            writer.write(static_cast<int64_t>(graphics->getCurrentFrameElapsedTime().count()));
+            ++shape_count;
+        });
+        writer.writeAt(shape_count_offset, shape_count);
+        ++body_count;
+    });
+    writer.writeAt(body_count_offset, body_count);
+
+    writer.write(static_cast<uint32_t>(m_joints.size()));
+    for(const auto & pair : m_joints)
+    {
+        const JointSnapshot joint = captureJointSnapshot(pair.first, pair.second);
+        writer.write(joint.gid);
+        writer.write(joint.type);
+        writer.write(joint.flags);
+        writer.write(joint.values);
+    }
+    return buffer;
+}
+
+std::optional<size_t> Scene::restore(std::span<const uint8_t> _snapshot)
+{
+    BinaryReader reader(_snapshot);
+    uint32_t magic;
+    uint16_t version;
+    b2Vec2 gravity;
+    uint32_t body_count;
+    if(!reader.read(magic) || magic != gc_snapshot_magic ||
+        !reader.read(version) || version != gc_snapshot_version ||
+        !reader.read(gravity) || !reader.read(body_count))
+    {
+        return std::nullopt;
+    }
+
+    // The whole snapshot is parsed before applying to leave the scene intact if the data is malformed.
+    // The counts are not trusted, the records are appended while there is data for them.
+    std::vector<BodySnapshot> bodies;
+    std::vector<BodyShapeSnapshot> shapes;
+    for(uint32_t i = 0; i < body_count; ++i)
+    {
+        BodySnapshot & body = bodies.emplace_back();
+        if(!reader.read(body.gid) || !reader.read(body.transform) || !reader.read(body.linear_velocity) ||
+            !reader.read(body.angular_velocity) || !reader.read(body.is_awake) || !reader.read(body.shape_count))
+        {
+            return std::nullopt;
+        }
+        for(uint32_t j = 0; j < body.shape_count; ++j)
+        {
+            BodyShapeSnapshot & shape = shapes.emplace_back();
+            if(!reader.readString(shape.key) || !reader.readString(shape.graphics_key) ||
+                !reader.read(shape.frame_index) || !reader.read(shape.iteration) ||
+                !reader.read(shape.frame_elapsed_time))
+            {
+                return std::nullopt;
+            }
+        }
+    }
+    uint32_t joint_count;
+    if(!reader.read(joint_count))
+        return std::nullopt;
+    std::vector<JointSnapshot> joints;
+    for(uint32_t i = 0; i < joint_count; ++i)
+    {
+        JointSnapshot & joint = joints.emplace_back();
+        if(!reader.read(joint.gid) || !reader.read(joint.type) || !reader.read(joint.flags) ||
+            !reader.read(joint.values))
+        {
+            return std::nullopt;
+        }
+    }
+    if(!reader.isAtEnd())
+        return std::nullopt;
+
+    b2World_SetGravity(m_b2_world_id, gravity);
+    size_t restored_count = 0;
+    size_t shape_index = 0;
+    for(const BodySnapshot & body_snapshot : bodies)
+    {
+        const size_t first_shape_index = shape_index;
+        shape_index += body_snapshot.shape_count;
+        Body * body = m_bodies.find(body_snapshot.gid);
+        if(!body || body->isDestructionPending())
+            continue;
+        const b2BodyId b2_body_id = body->getBox2dId();
+        invalidateOccupancy(b2_body_id);
+        b2Body_SetTransform(b2_body_id, body_snapshot.transform.p, body_snapshot.transform.q);
+        invalidateOccupancy(b2_body_id);
+        b2Body_SetLinearVelocity(b2_body_id, body_snapshot.linear_velocity);
+        b2Body_SetAngularVelocity(b2_body_id, body_snapshot.angular_velocity);
+        b2Body_SetAwake(b2_body_id, body_snapshot.is_awake != 0);
+        updateRenderProxy(getRenderProxy(b2_body_id), b2Body_GetTransform(b2_body_id));
+        for(size_t i = first_shape_index; i < shape_index; ++i)
+        {
+            const BodyShapeSnapshot & shape_snapshot = shapes[i];
+            BodyShape * shape = body->findShape(makePreHashedKey(shape_snapshot.key));
+            if(!shape || !shape->setCurrentGraphics(makePreHashedKey(shape_snapshot.graphics_key)))
+                continue;
+            shape->getCurrentGraphics()->restorePlayback(
+                shape_snapshot.frame_index,
+                shape_snapshot.iteration,
+                std::chrono::milliseconds(shape_snapshot.frame_elapsed_time));
+            m_animation_ticker.attach(body_snapshot.gid, *shape);
+        }
+        ++restored_count;
+    }
+    for(const JointSnapshot & joint_snapshot : joints)
+    {
+        const b2JointId b2_joint_id = findJoint(joint_snapshot.gid);
+        if(B2_IS_NON_NULL(b2_joint_id) && b2Joint_GetType(b2_joint_id) == joint_snapshot.type)
+            applyJointSnapshot(b2_joint_id, joint_snapshot);
+    }
+    return restored_count;
+}
+
 bool Scene::loadTileMap(const std::filesystem::path & _file_path)
 {
     deinitializeTileMap();
@@ -790,33 +1932,94 @@ bool Scene::loadTileMap(const std::filesystem::path & _file_path)
     return m_tile_map_ptr != nullptr; // TODO: only exceptions
 }
 
+bool Scene::beginSimulation(const StepState & _state)
+{
+    // Pre-solve observers are called from inside the Box2D step, so the world is stepped on the main thread
+    if(!m_tile_map_ptr || hasPreSolveObservers())
+        return false;
+    executeActions();
+    updateActivityRegion();
+    m_simulated_frame = _state.frame;
+    return true;
+}
+
+void Scene::simulate(const StepState & _state)
+{
+    stepWorld(_state);
+}
+
+bool Scene::hasPreSolveObservers() const
+{
+    return m_has_pre_solve_shapes && Observable<ContactObserver>::hasObservers();
+}
+
+void Scene::stepWorld(const StepState & _state)
+{
+    // Observers are not thread safe, Box2D calls the pre-solve callback from the workers
+    if(m_box2d_task_system_ptr)
+        m_box2d_task_system_ptr->setSerial(hasPreSolveObservers());
+    b2World_Step(m_b2_world_id, _state.delta_time.count() / 1000.0f, 4); // TODO: stable rate (1.0f / 60.0f), all from user settings
+}
+
 void Scene::step(const StepState & _state)
 {
     if(!m_tile_map_ptr)
     {
         return;
     }
-    m_defers.executeActions();
-    b2World_Step(m_b2_world_id, _state.delta_time.count() / 1000.0f, 4); // TODO: stable rate (1.0f / 60.0f), all from user settings
-    handleBox2dContactEvents();
+    // Only drawing is repeated for each outlet showing the scene
+    const bool is_new_frame = m_stepped_frame != _state.frame;
+    if(is_new_frame)
+    {
+        m_stepped_frame = _state.frame;
+        // The world has not been stepped by simulate in this frame, e.g. the scene was bound after it
+        if(m_simulated_frame != _state.frame)
+        {
+            executeActions();
+            updateActivityRegion();
+            stepWorld(_state);
+        }
+        notifyActivityChanges();
+        handleBox2dBodyEvents();
+        handleBox2dContactEvents();
+        m_animation_ticker.tick(_state.delta_time);
+        handleAnimationEvents();
+        dispatchPathResults();
+    }
     syncWorldWithFollowedBody();
 
-    std::unordered_set<uint64_t> bodies_to_render(m_bodies.size());
-    for(const auto & pair : m_bodies)
-        bodies_to_render.insert(pair.first);
-    drawLayersAndBodies(*m_tile_map_ptr, bodies_to_render, _state.delta_time);
-    for(const uint64_t body_id : bodies_to_render)
-        drawBody(m_bodies[body_id], _state.delta_time);
+    for(auto & pair : m_layer_bodies)
+        pair.second.is_drawn = false;
+    drawLayersAndBodies(*m_tile_map_ptr);
+    for(const auto & pair : m_layer_bodies)
+    {
+        if(!pair.second.is_drawn)
+        {
+            for(const b2BodyId & body_id : pair.second.bodies)
+                drawBody(getRenderProxy(body_id));
+        }
+    }
+    for(const b2BodyId & body_id : m_unlayered_bodies)
+        drawBody(getRenderProxy(body_id));
 
     if(mp_box2d_debug_draw)
         mp_box2d_debug_draw->draw();
 
-    Observable<StepObserver>::callObservers(&StepObserver::onStepComplete, _state);
+    if(is_new_frame)
+        Observable<StepObserver>::callObservers(&StepObserver::onStepComplete, _state);
 }
 
 bool Scene::box2dPreSolveContact(b2ShapeId _shape_id_a, b2ShapeId _shape_id_b, b2Manifold * _manifold, void * _context)
 {
     Scene * scene = static_cast<Scene *>(_context);
+    const BodyShape * shape_a = getUserData(_shape_id_a);
+    const BodyShape * shape_b = getUserData(_shape_id_b);
+    if(!shape_a || !shape_b)
+        return true;
+    if(!scene->m_pre_solve_rules.shouldCollide(shape_a->getTagId(), shape_b->getTagId(), *_manifold))
+        return false;
+    if(!shape_a->isPreSolveEnabled() && !shape_b->isPreSolveEnabled())
+        return true;
     bool result = true;
     PreSolveContact contact;
     if(!tryGetContactSide(_shape_id_a, contact.side_a) || !tryGetContactSide(_shape_id_b, contact.side_b))
@@ -830,8 +2033,39 @@ bool Scene::box2dPreSolveContact(b2ShapeId _shape_id_a, b2ShapeId _shape_id_b, b
     return result;
 }
 
+void Scene::handleBox2dBodyEvents()
+{
+    b2BodyEvents events = b2World_GetBodyEvents(m_b2_world_id);
+    for(int i = 0; i < events.moveCount; ++i)
+    {
+        const b2BodyMoveEvent & event = events.moveEvents[i];
+        BodyRenderProxy & proxy = getRenderProxy(event.bodyId);
+        if(B2_IS_NON_NULL(proxy.body_id))
+            updateRenderProxy(proxy, event.transform);
+    }
+}
+
+void Scene::handleAnimationEvents()
+{
+    for(const AnimationEvent & event : m_animation_ticker.takeEvents())
+    {
+        switch(event.type)
+        {
+        case AnimationEvent::Type::FrameChanged:
+            Observable<AnimationObserver>::callObservers(&AnimationObserver::onAnimationFrameChanged, event);
+            break;
+        case AnimationEvent::Type::LoopEnded:
+            Observable<AnimationObserver>::callObservers(&AnimationObserver::onAnimationLoopEnded, event);
+            break;
+        }
+    }
+}
+
 void Scene::handleBox2dContactEvents()
 {
+    const bool is_batching = Observable<ContactBatchObserver>::hasObservers();
+    size_t record_count = 0;
+
     {
         Contact contact;
         b2ContactEvents contact_events = b2World_GetContactEvents(m_b2_world_id);
@@ -839,13 +2073,29 @@ void Scene::handleBox2dContactEvents()
         {
             const b2ContactBeginTouchEvent & event = contact_events.beginEvents[i];
             if(tryGetContactSide(event.shapeIdA, contact.side_a) && tryGetContactSide(event.shapeIdB, contact.side_b))
+            {
                 Observable<ContactObserver>::callObservers(&ContactObserver::beginContact, contact);
+                if(is_batching)
+                {
+                    ContactRecord & record = appendContactRecord(ContactType::Begin, record_count);
+                    record.side_a = contact.side_a;
+                    record.side_b = contact.side_b;
+                }
+            }
         }
         for(int i = 0; i < contact_events.endCount; ++i)
         {
             const b2ContactEndTouchEvent & event = contact_events.endEvents[i];
             if(tryGetContactSide(event.shapeIdA, contact.side_a) && tryGetContactSide(event.shapeIdB, contact.side_b))
+            {
                 Observable<ContactObserver>::callObservers(&ContactObserver::endContact, contact);
+                if(is_batching)
+                {
+                    ContactRecord & record = appendContactRecord(ContactType::End, record_count);
+                    record.side_a = contact.side_a;
+                    record.side_b = contact.side_b;
+                }
+            }
         }
     }
 
@@ -859,6 +2109,12 @@ void Scene::handleBox2dContactEvents()
                 tryGetContactSide(event.visitorShapeId, contact.visitor))
             {
                 Observable<ContactObserver>::callObservers(&ContactObserver::beginSensorContact, contact);
+                if(is_batching)
+                {
+                    ContactRecord & record = appendContactRecord(ContactType::SensorBegin, record_count);
+                    record.side_a = contact.sensor;
+                    record.side_b = contact.visitor;
+                }
             }
         }
         for(int i = 0; i < sensor_events.endCount; ++i)
@@ -868,9 +2124,22 @@ void Scene::handleBox2dContactEvents()
                 tryGetContactSide(event.visitorShapeId, contact.visitor))
             {
                 Observable<ContactObserver>::callObservers(&ContactObserver::endSensorContact, contact);
+                if(is_batching)
+                {
+                    ContactRecord & record = appendContactRecord(ContactType::SensorEnd, record_count);
+                    record.side_a = contact.sensor;
+                    record.side_b = contact.visitor;
+                }
             }
         }
     }
+
+    if(record_count > 0)
+    {
+        Observable<ContactBatchObserver>::callObservers(
+            &ContactBatchObserver::onContacts,
+            std::span<const ContactRecord>(m_contact_records.data(), record_count));
+    }
 }
 
 bool Scene::tryGetContactSide(b2ShapeId _shape_id, ContactSide & _contact_side)
@@ -883,6 +2152,7 @@ bool Scene::tryGetContactSide(b2ShapeId _shape_id, ContactSide & _contact_side)
         _contact_side.body_id = body->getGid();
         _contact_side.shape_key = shape->getKey();
         _contact_side.tile_map_object_id = shape->getTileMapObjectId();
+        _contact_side.tag = shape->getTag();
         return true;
     }
     return false;
@@ -922,36 +2192,47 @@ void Scene::syncWorldWithFollowedBody()
     }
 }
 
-void Scene::drawBody(b2BodyId _body_id, std::chrono::milliseconds _delta_time)
+void Scene::initRenderProxy(b2BodyId _body_id)
 {
-    SDL_FPoint body_position;
-    {
-        b2Vec2 pos = b2Body_GetPosition(_body_id);
-        body_position = toAbsoluteCoords(physicalToGraphical(pos.x), physicalToGraphical(pos.y));
-    }
-    int shape_count = b2Body_GetShapeCount(_body_id);
-    std::vector<b2ShapeId> shapes(shape_count);
-    b2Body_GetShapes(_body_id, shapes.data(), shape_count);
-    b2Rot b2_rotation = b2Body_GetRotation(_body_id);
-    Rotation rotation(b2_rotation.s, b2_rotation.c);
-    for(const b2ShapeId & shape_id : shapes)
+    BodyRenderProxy & proxy = getRenderProxy(_body_id);
+    proxy.body_id = _body_id;
+    proxy.shapes.clear();
+    updateRenderProxy(proxy, b2Body_GetTransform(_body_id));
+}
+
+void Scene::updateRenderProxy(BodyRenderProxy & _proxy, const b2Transform & _transform)
+{
+    _proxy.position.x = physicalToGraphical(_transform.p.x);
+    _proxy.position.y = physicalToGraphical(_transform.p.y);
+    _proxy.rotation.reset(_transform.q.s, _transform.q.c);
+}
+
+void Scene::releaseRenderProxy(b2BodyId _body_id)
+{
+    BodyRenderProxy & proxy = getRenderProxy(_body_id);
+    proxy.body_id = b2_nullBodyId;
+    proxy.shapes.clear();
+}
+
+void Scene::drawBody(const BodyRenderProxy & _proxy)
+{
+    if(getUserData(_proxy.body_id)->isDestructionPending())
+        return;
+    const SDL_FPoint body_position = toAbsoluteCoords(_proxy.position.x, _proxy.position.y);
+    for(BodyShape * shape : _proxy.shapes)
     {
-        BodyShape * shape = getUserData(shape_id);
         GraphicsPack * graphics = shape->getCurrentGraphics();
         if(graphics)
         {
             // TODO: How to rotate multiple shapes?
-            graphics->render(body_position, rotation, _delta_time);
+            graphics->render(body_position, _proxy.rotation);
         }
     }
 }
 
-void Scene::drawLayersAndBodies(
-    const TileMapLayerContainer & _container,
-    std::unordered_set<uint64_t> & _bodies_to_render,
-    std::chrono::milliseconds _delta_time)
+void Scene::drawLayersAndBodies(const TileMapLayerContainer & _container)
 {
-    _container.forEachLayer([&_bodies_to_render, _delta_time, this](const TileMapLayer & __layer) {
+    _container.forEachLayer([this](const TileMapLayer & __layer) {
         if(!__layer.isVisible()) return;
         switch(__layer.getType())
         {
@@ -969,15 +2250,15 @@ void Scene::drawLayersAndBodies(
         {
             const TileMapGroupLayer & group = dynamic_cast<const TileMapGroupLayer &>(__layer);
             if(group.isVisible())
-                drawLayersAndBodies(group, _bodies_to_render, _delta_time);
+                drawLayersAndBodies(group);
             break;
         }}
-        for(const auto & pair : m_bodies)
+        auto layer_bodies_it = m_layer_bodies.find(__layer.getName());
+        if(layer_bodies_it != m_layer_bodies.end() && !layer_bodies_it->second.is_drawn)
         {
-            b2BodyId box2d_body_id = pair.second;
-            const Body * body = getUserData(box2d_body_id);
-            if(body->getLayer() == __layer.getName() && _bodies_to_render.erase(pair.first))
-                drawBody(box2d_body_id, _delta_time);
+            layer_bodies_it->second.is_drawn = true;
+            for(const b2BodyId & body_id : layer_bodies_it->second.bodies)
+                drawBody(getRenderProxy(body_id));
         }
     });
 }
@@ -1171,21 +2452,356 @@ bool Scene::doesBodyShapeExist(uint64_t _body_id, const PreHashedKey<std::string
 std::optional<std::vector<SDL_FPoint>> Scene::findPath(
     uint64_t _body_id,
     const SDL_FPoint & _destination,
-    bool _allow_diagonal_steps,
-    bool _avoid_sensors) const
+    const AStarOptions & _options,
+    bool * _is_complete)
 {
     const b2BodyId b2_body_id = findBox2dBody(_body_id);
     if(B2_IS_NULL(b2_body_id))
         return std::nullopt;
-    AStarOptions options;
-    options.allow_diagonal_steps = _allow_diagonal_steps;
-    options.avoid_sensors = _avoid_sensors;
-    auto b2_result = aStarFindPath(m_b2_world_id, b2_body_id, toBox2D(_destination), options);
+    const b2Vec2 cell_size = OccupancyGridCache::calculateCellSize(b2_body_id);
+    std::optional<AStarResult> b2_result;
+    if(_options.is_hierarchical)
+    {
+        ClusterGraph & graph = m_occupancy_grids.getClusterGraph(
+            m_b2_world_id,
+            cell_size,
+            _options.avoid_sensors,
+            _options.allow_diagonal_steps);
+        b2_result = m_hierarchical_astar.findPath(
+            graph,
+            m_astar,
+            b2Body_GetPosition(b2_body_id),
+            toBox2D(_destination),
+            _options);
+    }
+    else
+    {
+        OccupancyGrid & grid = m_occupancy_grids.getGrid(m_b2_world_id, cell_size, _options.avoid_sensors);
+        b2_result = m_astar.findPath(grid, b2Body_GetPosition(b2_body_id), toBox2D(_destination), _options);
+    }
     if(!b2_result.has_value())
         return std::nullopt;
+    if(_is_complete)
+        *_is_complete = b2_result.value().is_complete;
     std::vector<SDL_FPoint> result;
-    result.reserve(b2_result.value().size());
-    for(size_t i = 0; i < b2_result.value().size(); ++i)
-        result.push_back(toSDL(b2_result.value()[i]));
+    result.reserve(b2_result.value().points.size());
+    for(size_t i = 0; i < b2_result.value().points.size(); ++i)
+        result.push_back(toSDL(b2_result.value().points[i]));
+    return result;
+}
+
+std::optional<uint64_t> Scene::requestPath(
+    uint64_t _body_id,
+    const SDL_FPoint & _destination,
+    const AStarOptions & _options,
+    bool _keep_result)
+{
+    const b2BodyId b2_body_id = findBox2dBody(_body_id);
+    if(B2_IS_NULL(b2_body_id))
+        return std::nullopt;
+    if(!m_path_finder_ptr)
+        m_path_finder_ptr = std::make_unique<AsyncPathFinder>(m_path_worker_count);
+    PathRequest request
+    {
+        .id = m_path_request_id.getNext(),
+        .start = b2Body_GetPosition(b2_body_id),
+        .destination = toBox2D(_destination),
+        .options = _options,
+        .snapshot = m_occupancy_grids.getSnapshot(
+            m_b2_world_id,
+            OccupancyGridCache::calculateCellSize(b2_body_id),
+            _options.avoid_sensors,
+            [this, &_options](std::vector<b2AABB> & __aabbs) {
+                collectStaticShapeAabbs(_options.avoid_sensors, __aabbs);
+            })
+    };
+    const uint64_t request_id = request.id;
+    m_pending_path_requests.emplace(request_id, _keep_result);
+    m_path_finder_ptr->enqueue(std::move(request));
+    return request_id;
+}
+
+bool Scene::cancelPathRequest(uint64_t _request_id)
+{
+    if(m_pending_path_requests.erase(_request_id))
+    {
+        m_path_finder_ptr->cancel(_request_id);
+        return true;
+    }
+    return m_path_results.erase(_request_id) > 0;
+}
+
+std::optional<PathResult> Scene::takePathResult(uint64_t _request_id)
+{
+    auto it = m_path_results.find(_request_id);
+    if(it == m_path_results.end())
+        return std::nullopt;
+    PathResult result = std::move(it->second);
+    m_path_results.erase(it);
     return result;
 }
+
+void Scene::dispatchPathResults()
+{
+    if(!m_path_finder_ptr)
+        return;
+    PathResponse response;
+    for(uint32_t count = 0; m_path_completion_budget == 0 || count < m_path_completion_budget;)
+    {
+        if(!m_path_finder_ptr->tryTakeResponse(response))
+            break;
+        auto it = m_pending_path_requests.find(response.id);
+        if(it == m_pending_path_requests.end())
+            continue; // Cancelled while being processed
+        const bool keep_result = it->second;
+        m_pending_path_requests.erase(it);
+        ++count;
+        PathResult result = makePathResult(response.result);
+        Observable<PathObserver>::forEachObserver([&response, &result](PathObserver & __observer) {
+            __observer.onPathFound(response.id, result);
+            return true;
+        });
+        if(keep_result)
+            m_path_results.emplace(response.id, std::move(result));
+    }
+}
+
+PathResult Scene::makePathResult(const std::optional<AStarResult> & _result) const
+{
+    if(!_result.has_value())
+        return PathResult { .points = std::nullopt, .is_complete = false };
+    std::vector<SDL_FPoint> points;
+    points.reserve(_result.value().points.size());
+    for(const b2Vec2 & point : _result.value().points)
+        points.push_back(toSDL(point));
+    return PathResult { .points = std::move(points), .is_complete = _result.value().is_complete };
+}
+
+std::optional<uint64_t> Scene::createFlowField(const SDL_FPoint & _goal, const FlowFieldOptions & _options)
+{
+    std::optional<FSize> cell_size = _options.cell_size;
+    std::optional<SDL_FRect> area = _options.area;
+    if(m_tile_map_ptr)
+    {
+        // The tile map is measured in pixels, the area and the cell size are in meters as positions of bodies
+        const float tile_width = graphicalToPhysical(static_cast<float>(m_tile_map_ptr->getTileWidth()));
+        const float tile_height = graphicalToPhysical(static_cast<float>(m_tile_map_ptr->getTileHeight()));
+        if(!cell_size.has_value())
+            cell_size = FSize(tile_width, tile_height);
+        if(!area.has_value())
+            area = SDL_FRect { .x = .0f, .y = .0f, .w = m_tile_map_ptr->getWidth() * tile_width, .h = m_tile_map_ptr->getHeight() * tile_height };
+    }
+    if(!cell_size.has_value() || !area.has_value() || cell_size.value().w <= .0f || cell_size.value().h <= .0f)
+        return std::nullopt;
+    const b2Vec2 b2_cell_size { .x = cell_size.value().w, .y = cell_size.value().h };
+    const OccupancyGrid & grid = m_occupancy_grids.getGrid(m_b2_world_id, b2_cell_size, _options.avoid_sensors);
+    const b2AABB aabb
+    {
+        .lowerBound = toBox2D(SDL_FPoint { .x = area.value().x, .y = area.value().y }),
+        .upperBound = toBox2D(SDL_FPoint { .x = area.value().x + area.value().w, .y = area.value().y + area.value().h })
+    };
+    std::unique_ptr<FlowField> flow_field = std::make_unique<FlowField>(
+        grid.getCellRect(aabb),
+        b2_cell_size,
+        _options.allow_diagonal_steps,
+        _options.avoid_sensors);
+    buildFlowField(*flow_field, toBox2D(_goal));
+    const uint64_t id = m_flow_field_id.getNext();
+    m_flow_fields.emplace(id, std::move(flow_field));
+    return id;
+}
+
+bool Scene::setFlowFieldGoal(uint64_t _flow_field_id, const SDL_FPoint & _goal)
+{
+    auto it = m_flow_fields.find(_flow_field_id);
+    if(it == m_flow_fields.end())
+        return false;
+    buildFlowField(*it->second, toBox2D(_goal));
+    return true;
+}
+
+std::optional<SDL_FPoint> Scene::getFlowDirection(uint64_t _flow_field_id, const SDL_FPoint & _point)
+{
+    const FlowField * flow_field = getActualFlowField(_flow_field_id);
+    if(!flow_field)
+        return std::nullopt;
+    std::optional<b2Vec2> direction = flow_field->getDirection(toBox2D(_point));
+    if(!direction.has_value())
+        return std::nullopt;
+    return toSDL(direction.value());
+}
+
+// Sets the velocities of the bodies along the field, the bodies that cannot reach the goal are not changed
+size_t Scene::applyFlowField(uint64_t _flow_field_id, std::span<const uint64_t> _body_ids, float _speed)
+{
+    const FlowField * flow_field = getActualFlowField(_flow_field_id);
+    if(!flow_field)
+        return 0;
+    size_t count = 0;
+    for(uint64_t body_id : _body_ids)
+    {
+        const b2BodyId b2_body_id = findBox2dBody(body_id);
+        if(B2_IS_NULL(b2_body_id))
+            continue;
+        const std::optional<b2Vec2> direction = flow_field->getDirection(b2Body_GetPosition(b2_body_id));
+        if(!direction.has_value())
+            continue;
+        b2Body_SetLinearVelocity(b2_body_id, b2MulSV(_speed, direction.value()));
+        ++count;
+    }
+    return count;
+}
+
+bool Scene::destroyFlowField(uint64_t _flow_field_id)
+{
+    return m_flow_fields.erase(_flow_field_id) > 0;
+}
+
+FlowField * Scene::getActualFlowField(uint64_t _flow_field_id)
+{
+    auto it = m_flow_fields.find(_flow_field_id);
+    if(it == m_flow_fields.end())
+        return nullptr;
+    if(it->second->isOutdated())
+        buildFlowField(*it->second, it->second->getGoal());
+    return it->second.get();
+}
+
+void Scene::buildFlowField(FlowField & _flow_field, const b2Vec2 & _goal)
+{
+    OccupancyGrid & grid = m_occupancy_grids.getGrid(
+        m_b2_world_id,
+        _flow_field.getCellSize(),
+        _flow_field.doesAvoidSensors());
+    _flow_field.build(grid, _goal);
+}
+
+// The fields are rebuilt lazily when they are used the next time
+void Scene::invalidateFlowFields()
+{
+    for(auto & pair : m_flow_fields)
+        pair.second->invalidate();
+}
+
+void Scene::collectStaticShapeAabbs(bool _include_sensors, std::vector<b2AABB> & _aabbs) const
+{
+    std::vector<b2ShapeId> shape_ids;
+    auto collect = [&](b2BodyId __body_id) {
+        if(b2Body_GetType(__body_id) != b2_staticBody)
+            return;
+        shape_ids.resize(b2Body_GetShapeCount(__body_id));
+        b2Body_GetShapes(__body_id, shape_ids.data(), static_cast<int>(shape_ids.size()));
+        for(const b2ShapeId & shape_id : shape_ids)
+        {
+            if(_include_sensors || !b2Shape_IsSensor(shape_id))
+                _aabbs.push_back(b2Shape_GetAABB(shape_id));
+        }
+    };
+    for(const b2BodyId & body_id : m_unlayered_bodies)
+        collect(body_id);
+    for(const auto & pair : m_layer_bodies)
+    {
+        for(const b2BodyId & body_id : pair.second.bodies)
+            collect(body_id);
+    }
+}
+
+b2QueryFilter Scene::createBox2dQueryFilter(const CollisionFilterDefinition & _definition) const
+{
+    const b2Filter filter = createBox2dFilter(_definition);
+    return b2QueryFilter { .categoryBits = filter.categoryBits, .maskBits = filter.maskBits };
+}
+
+void Scene::setQueryHit(std::optional<QueryHit> & _hit, b2ShapeId _shape_id, b2Vec2 _point, b2Vec2 _normal, float _fraction)
+{
+    const BodyShape * shape = getUserData(_shape_id);
+    const Body * body = getUserData(b2Shape_GetBody(_shape_id));
+    if(!shape || !body)
+        return;
+    _hit = QueryHit
+    {
+        .body_id = body->getGid(),
+        .shape_key = shape->getKey(),
+        .point = toSDL(_point),
+        .normal = toSDL(_normal),
+        .fraction = _fraction
+    };
+}
+
+QueryHits Scene::castRays(std::span<const RayCastQuery> _queries, const QueryOptions & _options)
+{
+    QueryHits hits(_queries.size());
+    const b2QueryFilter filter = createBox2dQueryFilter(_options.filter);
+    executeQueries(m_box2d_task_system_ptr.get(), _queries.size(), _options.is_parallel, [&](size_t __index) {
+        const RayCastQuery & query = _queries[__index];
+        const b2Vec2 origin = toBox2D(query.from);
+        const b2Vec2 translation = b2Sub(toBox2D(query.to), origin);
+        ClosestCastHit hit;
+        b2World_CastRay(m_b2_world_id, origin, translation, filter, &ClosestCastHit::callback, &hit);
+        if(B2_IS_NON_NULL(hit.shape_id))
+            setQueryHit(hits[__index], hit.shape_id, hit.point, hit.normal, hit.fraction);
+    });
+    return hits;
+}
+
+QueryHits Scene::castShapes(std::span<const ShapeCastQuery> _queries, const QueryOptions & _options)
+{
+    QueryHits hits(_queries.size());
+    const b2QueryFilter filter = createBox2dQueryFilter(_options.filter);
+    executeQueries(m_box2d_task_system_ptr.get(), _queries.size(), _options.is_parallel, [&](size_t __index) {
+        const ShapeCastQuery & query = _queries[__index];
+        const b2Transform transform = { .p = toBox2D(query.from), .q = b2Rot_identity };
+        const b2Vec2 translation = b2Sub(toBox2D(query.to), transform.p);
+        ClosestCastHit hit;
+        if(const CircleCastGeometry * circle = std::get_if<CircleCastGeometry>(&query.geometry))
+        {
+            const b2Circle b2_circle = { .center = { .x = .0f, .y = .0f }, .radius = graphicalToPhysical(circle->radius) };
+            b2World_CastCircle(m_b2_world_id, &b2_circle, transform, translation, filter, &ClosestCastHit::callback, &hit);
+        }
+        else if(const RectCastGeometry * rect = std::get_if<RectCastGeometry>(&query.geometry))
+        {
+            // The rect is anchored at its top left corner as the rects of overlapRects
+            const float half_w = graphicalToPhysical(rect->w) / 2.0f;
+            const float half_h = graphicalToPhysical(rect->h) / 2.0f;
+            const b2Polygon b2_box = b2MakeOffsetBox(half_w, half_h, b2Vec2 { .x = half_w, .y = half_h }, b2Rot_identity);
+            b2World_CastPolygon(m_b2_world_id, &b2_box, transform, translation, filter, &ClosestCastHit::callback, &hit);
+        }
+        if(B2_IS_NON_NULL(hit.shape_id))
+            setQueryHit(hits[__index], hit.shape_id, hit.point, hit.normal, hit.fraction);
+    });
+    return hits;
+}
+
+OverlapResults Scene::overlapRects(std::span<const SDL_FRect> _rects, const QueryOptions & _options)
+{
+    struct Overlap
+    {
+        static bool callback(b2ShapeId _shape_id, void * _context)
+        {
+            if(b2Shape_IsSensor(_shape_id))
+                return true;
+            std::vector<uint64_t> & body_ids = *static_cast<std::vector<uint64_t> *>(_context);
+            const Body * body = getUserData(b2Shape_GetBody(_shape_id));
+            if(body && !body->isDestructionPending())
+            {
+                if(std::find(body_ids.begin(), body_ids.end(), body->getGid()) == body_ids.end())
+                    body_ids.push_back(body->getGid());
+            }
+            return true;
+        }
+    };
+
+    OverlapResults results(_rects.size());
+    const b2QueryFilter filter = createBox2dQueryFilter(_options.filter);
+    executeQueries(m_box2d_task_system_ptr.get(), _rects.size(), _options.is_parallel, [&](size_t __index) {
+        const SDL_FRect & rect = _rects[__index];
+        const float half_w = graphicalToPhysical(rect.w) / 2.0f;
+        const float half_h = graphicalToPhysical(rect.h) / 2.0f;
+        // The polygon gives exact results unlike the fat AABBs of the broadphase
+        const b2Polygon b2_box = b2MakeBox(half_w, half_h);
+        const b2Transform transform = { .p = { .x = rect.x + half_w, .y = rect.y + half_h }, .q = b2Rot_identity };
+        b2World_OverlapPolygon(m_b2_world_id, &b2_box, transform, filter, &Overlap::callback, &results[__index]);
+    });
+    return results;
+}
+
@@ -17,16 +17,24 @@
 #pragma once
 
 #include <Sol2D/World/Body.h>
+#include <Sol2D/World/AnimationTicker.h>
 #include <Sol2D/World/BodyDefinition.h>
+#include <Sol2D/World/BodyPrototype.h>
 #include <Sol2D/World/Joint.h>
 #include <Sol2D/World/JointDefinition.h>
 #include <Sol2D/World/BodyOptions.h>
 #include <Sol2D/World/Contact.h>
+#include <Sol2D/World/PreSolveRules.h>
+#include <Sol2D/World/SpatialQuery.h>
 #include <Sol2D/World/ActionQueue.h>
+#include <Sol2D/World/AsyncPathFinder.h>
+#include <Sol2D/World/FlowField.h>
 #include <Sol2D/World/Box2dDebugDraw.h>
+#include <Sol2D/World/Box2dTaskSystem.h>
 #include <Sol2D/Tiles/TileMap.h>
 #include <Sol2D/Utils/Observable.h>
 #include <Sol2D/Utils/PreHashedMap.h>
+#include <Sol2D/Utils/SequentialId.h>
 #include <Sol2D/Canvas.h>
 #include <Sol2D/Workspace.h>
 #include <filesystem>
@@ -38,14 +46,20 @@ struct SceneOptions
 {
     SceneOptions() :
         meters_per_pixel(default_meters_per_pixel),
-        gravity{.0f, .0f}
+        gravity{.0f, .0f},
+        path_worker_count(1),
+        path_completion_budget(default_path_completion_budget)
     {
     }
 
     static constexpr float default_meters_per_pixel = 0.01f;
+    static constexpr uint32_t default_path_completion_budget = 8;
 
     float meters_per_pixel;
     SDL_FPoint gravity;
+    std::optional<uint32_t> physics_worker_count;
+    uint32_t path_worker_count;
+    uint32_t path_completion_budget; // Completed path requests dispatched per step, 0 - unlimited
 };
 
 class StepObserver
@@ -55,32 +69,114 @@ public:
     virtual void onStepComplete(const StepState & _state) = 0;
 };
 
+struct PathResult
+{
+    std::optional<std::vector<SDL_FPoint>> points;
+    bool is_complete;
+};
+
+class PathObserver
+{
+public:
+    virtual ~PathObserver() { }
+    virtual void onPathFound(uint64_t _request_id, const PathResult & _result) = 0;
+};
+
+// Distances are in pixels
+struct ActivityRegionOptions
+{
+    float camera_margin = .0f;
+    float focus_radius = .0f; // Half of the side of the square around each focus body
+    float hysteresis = .0f; // How far a body has to leave the region to be disabled
+};
+
+class BodyActivityObserver
+{
+public:
+    virtual ~BodyActivityObserver() { }
+    virtual void onBodyActivityChanged(uint64_t _body_id, bool _is_active) = 0;
+};
+
 class Scene final :
     public Canvas,
     public Utils::Observable<ContactObserver>,
-    public Utils::Observable<StepObserver>
+    public Utils::Observable<ContactBatchObserver>,
+    public Utils::Observable<StepObserver>,
+    public Utils::Observable<AnimationObserver>,
+    public Utils::Observable<PathObserver>,
+    public Utils::Observable<BodyActivityObserver>
 {
 private:
-    class BodyShapeCreator;
-    friend class Scene::BodyShapeCreator;
+    class BodyPrototypeShapeBuilder;
+    friend class Scene::BodyPrototypeShapeBuilder;
+
+    struct BodyRenderProxy
+    {
+        b2BodyId body_id = b2_nullBodyId;
+        SDL_FPoint position = { .x = .0f, .y = .0f };
+        Rotation rotation;
+        std::vector<BodyShape *> shapes;
+    };
+
+    struct LayerBodies
+    {
+        std::vector<b2BodyId> bodies;
+        bool is_drawn = false;
+    };
+
+    struct TileLayerCollision
+    {
+        BodyOptions body_options;
+        uint32_t shape_tag_id = 0;
+        std::unordered_map<uint64_t, uint64_t> chunk_bodies; // Chunk key to body ID
+    };
 
 public:
     using Utils::Observable<ContactObserver>::addObserver;
     using Utils::Observable<ContactObserver>::removeObserver;
+    using Utils::Observable<ContactBatchObserver>::addObserver;
+    using Utils::Observable<ContactBatchObserver>::removeObserver;
     using Utils::Observable<StepObserver>::addObserver;
     using Utils::Observable<StepObserver>::removeObserver;
+    using Utils::Observable<AnimationObserver>::addObserver;
+    using Utils::Observable<AnimationObserver>::removeObserver;
+    using Utils::Observable<PathObserver>::addObserver;
+    using Utils::Observable<PathObserver>::removeObserver;
+    using Utils::Observable<BodyActivityObserver>::addObserver;
+    using Utils::Observable<BodyActivityObserver>::removeObserver;
 
 public:
     Scene(const SceneOptions & _options, const Workspace & _workspace, Renderer & _renderer);
     ~Scene() override;
     void setGravity(const SDL_FPoint & _vector);
     uint64_t createBody(const SDL_FPoint & _position, const BodyDefinition & _definition);
+    std::vector<uint64_t> createBodies(const std::vector<SDL_FPoint> & _positions, const BodyDefinition & _definition);
+    uint64_t createBodyPrototype(const std::string & _name, const BodyDefinition & _definition);
+    std::optional<uint64_t> findBodyPrototype(const std::string & _name) const;
+    std::optional<uint64_t> createBodyFromPrototype(
+        uint64_t _prototype_id,
+        const SDL_FPoint & _position,
+        const BodyPrototypeOverrides & _overrides);
     void createBodiesFromMapObjects(const std::string & _class, const BodyOptions & _body_options);
+    bool createBodiesFromTileLayer(const std::string & _layer_name, const BodyOptions & _body_options);
+    bool setTile(const std::string & _layer_name, int32_t _x, int32_t _y, uint32_t _gid);
+    bool eraseTile(const std::string & _layer_name, int32_t _x, int32_t _y);
     Body * getBody(uint64_t _body_id);
     bool destroyBody(uint64_t _body_id);
     bool setFollowedBody(uint64_t _body_id);
     void resetFollowedBody();
     bool setBodyLayer(uint64_t _body_id, const std::string & _layer);
+    bool setBodyPosition(uint64_t _body_id, const SDL_FPoint & _position);
+    void setActivityRegion(const ActivityRegionOptions & _options);
+    void resetActivityRegion();
+    bool addActivityFocus(uint64_t _body_id);
+    bool removeActivityFocus(uint64_t _body_id);
+    std::optional<bool> isBodyActive(uint64_t _body_id) const;
+    bool declareCollisionCategory(const std::string & _name);
+    void setOneWayNormal(const std::string & _tag, const SDL_FPoint & _normal);
+    bool removeOneWayNormal(const std::string & _tag);
+    void ignoreTagContacts(const std::string & _tag_a, const std::string & _tag_b);
+    bool restoreTagContacts(const std::string & _tag_a, const std::string & _tag_b);
     GraphicsPack * getBodyShapeGraphicsPack(
         uint64_t _body_id,
         const Utils::PreHashedKey<std::string> & _shape_key,
@@ -107,39 +203,111 @@ public:
     std::optional<WeldJoint> getWeldJoint(uint64_t _id) const;
     std::optional<WheelJoint> getWheelJoint(uint64_t _id) const;
     bool destroyJoint(uint64_t _joint_id);
+    std::vector<uint8_t> snapshot();
+    std::optional<size_t> restore(std::span<const uint8_t> _snapshot);
     bool loadTileMap(const std::filesystem::path & _file_path);
     const Tiles::TileMapObject * getTileMapObjectById(uint32_t _id) const;
     const Tiles::TileMapObject * getTileMapObjectByName(const std::string & _name) const;
     boost::container::slist<const Tiles::TileMapObject *> getTileMapObjectsByClass(const std::string & _class) const;
+    bool beginSimulation(const StepState & _state) override;
+    void simulate(const StepState & _state) override;
     void step(const StepState & _state) override;
     bool doesBodyExist(uint64_t _body_id) const;
     bool doesBodyShapeExist(uint64_t _body_id, const Utils::PreHashedKey<std::string> & _shape_key) const;
     std::optional<std::vector<SDL_FPoint> > findPath(
         uint64_t _body_id,
         const SDL_FPoint & _destination,
-        bool _allow_diagonal_steps,
-        bool _avoid_sensors) const;
+        const AStarOptions & _options,
+        bool * _is_complete = nullptr);
+    std::optional<uint64_t> requestPath(
+        uint64_t _body_id,
+        const SDL_FPoint & _destination,
+        const AStarOptions & _options,
+        bool _keep_result);
+    bool cancelPathRequest(uint64_t _request_id);
+    std::optional<PathResult> takePathResult(uint64_t _request_id);
+    std::optional<uint64_t> createFlowField(const SDL_FPoint & _goal, const FlowFieldOptions & _options);
+    bool setFlowFieldGoal(uint64_t _flow_field_id, const SDL_FPoint & _goal);
+    std::optional<SDL_FPoint> getFlowDirection(uint64_t _flow_field_id, const SDL_FPoint & _point);
+    size_t applyFlowField(uint64_t _flow_field_id, std::span<const uint64_t> _body_ids, float _speed);
+    bool destroyFlowField(uint64_t _flow_field_id);
+    QueryHits castRays(std::span<const RayCastQuery> _queries, const QueryOptions & _options);
+    QueryHits castShapes(std::span<const ShapeCastQuery> _queries, const QueryOptions & _options);
+    OverlapResults overlapRects(std::span<const SDL_FRect> _rects, const QueryOptions & _options);
 
 private:
     float physicalToGraphical(float _value);
     float graphicalToPhysical(float _value);
     void deinitializeTileMap();
+    void executeActions();
+    void stepWorld(const StepState & _state);
+    bool hasPreSolveObservers() const;
+    Body & createMapObjectBody(const b2BodyDef & _b2_body_def);
+    BodyShape & createMapObjectBodyShape(
+        Body & _body,
+        const std::string & _key,
+        std::optional<uint32_t> _tile_map_object_id,
+        const BodyShapePhysicsDefinition & _physics,
+        uint32_t _tag_id);
+    void createStaticRectShape(b2BodyId _body_id, const b2ShapeDef & _b2_shape_def, const SDL_FRect & _rect);
+    Tiles::TileMapTileLayer * findTileLayer(const std::string & _layer_name);
+    void buildTileLayerChunk(
+        const Tiles::TileMapTileLayer & _layer,
+        TileLayerCollision & _collision,
+        int32_t _chunk_x,
+        int32_t _chunk_y);
+    void rebuildTileLayerChunk(const Tiles::TileMapTileLayer & _layer, int32_t _x, int32_t _y);
+    void createMapObjectShape(
+        Body & _body,
+        const Tiles::TileMapObject & _map_object,
+        const SDL_FPoint & _offset,
+        b2ShapeDef & _b2_shape_def,
+        const std::string & _shape_key,
+        const BodyOptions & _body_options,
+        uint32_t _tag_id);
+    void updateActivityRegion();
+    void notifyActivityChanges();
+    bool destroyBodyImmediately(uint64_t _body_id);
     static b2BodyType mapBodyType(BodyType _type);
+    static b2BodyDef createBox2dBodyDef(const BodyDefinition & _definition);
+    std::vector<BodyPrototypeShape> createBodyPrototypeShapes(const BodyDefinition & _definition);
+    uint64_t createBody(
+        const SDL_FPoint & _position,
+        const BodyPrototype & _prototype,
+        const BodyPrototypeOverrides * _overrides);
+    uint32_t registerShapeTag(const std::optional<std::string> & _tag);
+    uint32_t getCollisionCategoryBits(const std::vector<std::string> & _names) const;
+    b2Filter createBox2dFilter(const CollisionFilterDefinition & _definition) const;
+    b2QueryFilter createBox2dQueryFilter(const CollisionFilterDefinition & _definition) const;
+    void setQueryHit(std::optional<QueryHit> & _hit, b2ShapeId _shape_id, b2Vec2 _point, b2Vec2 _normal, float _fraction);
     static bool box2dPreSolveContact(
         b2ShapeId _shape_id_a,
         b2ShapeId _shape_id_b,
         b2Manifold * _manifold,
         void * _context);
+    void handleBox2dBodyEvents();
     void handleBox2dContactEvents();
+    ContactRecord & appendContactRecord(ContactType _type, size_t & _count);
+    void handleAnimationEvents();
     static bool tryGetContactSide(b2ShapeId _shape_id, ContactSide & _contact_side);
     void syncWorldWithFollowedBody();
-    void drawLayersAndBodies(
-        const Tiles::TileMapLayerContainer & _container,
-        std::unordered_set<uint64_t> & _bodies_to_render,
-        std::chrono::milliseconds _delta_time);
+    void attachBodyToLayer(b2BodyId _body_id, const std::optional<std::string> & _layer);
+    void detachBodyFromLayer(b2BodyId _body_id, const std::optional<std::string> & _layer);
+    void invalidateOccupancy(b2BodyId _body_id);
+    void collectStaticShapeAabbs(bool _include_sensors, std::vector<b2AABB> & _aabbs) const;
+    void dispatchPathResults();
+    PathResult makePathResult(const std::optional<AStarResult> & _result) const;
+    FlowField * getActualFlowField(uint64_t _flow_field_id);
+    void buildFlowField(FlowField & _flow_field, const b2Vec2 & _goal);
+    void invalidateFlowFields();
+    BodyRenderProxy & getRenderProxy(b2BodyId _body_id);
+    void initRenderProxy(b2BodyId _body_id);
+    void updateRenderProxy(BodyRenderProxy & _proxy, const b2Transform & _transform);
+    void releaseRenderProxy(b2BodyId _body_id);
+    void drawLayersAndBodies(const Tiles::TileMapLayerContainer & _container);
     b2BodyId findBox2dBody(uint64_t _body_id) const;
     b2JointId findJoint(uint64_t _joint_id) const;
-    void drawBody(b2BodyId _body_id, std::chrono::milliseconds _delta_time);
+    void drawBody(const BodyRenderProxy & _proxy);
     void drawObjectLayer(const Tiles::TileMapObjectLayer & _layer);
     void drawPolyXObject(const Tiles::TileMapPolyX & _poly, bool _close);
     void drawCircle(const Tiles::TileMapCircle & _circle);
@@ -154,14 +322,44 @@ private:
     SDL_FPoint m_world_offset;
     b2WorldId m_b2_world_id;
     float m_meters_per_pixel;
-    std::unordered_map<uint64_t, b2BodyId> m_bodies;
+    Utils::SlotMap<BodyShape> m_body_shapes;
+    Utils::SlotMap<Body> m_bodies;
+    Utils::SlotMap<BodyPrototype> m_body_prototypes;
+    std::unordered_map<std::string, uint64_t> m_body_prototype_ids;
     std::unordered_map<uint64_t, b2JointId> m_joints;
+    std::unordered_map<std::string, LayerBodies> m_layer_bodies;
+    std::vector<b2BodyId> m_unlayered_bodies;
+    std::vector<BodyRenderProxy> m_render_proxies;
+    std::vector<ContactRecord> m_contact_records;
+    PreSolveRules m_pre_solve_rules;
+    OccupancyGridCache m_occupancy_grids;
+    AStar m_astar;
+    HierarchicalAStar m_hierarchical_astar;
+    std::unique_ptr<AsyncPathFinder> m_path_finder_ptr;
+    const uint32_t m_path_worker_count;
+    const uint32_t m_path_completion_budget;
+    Utils::SequentialId<uint64_t> m_path_request_id;
+    std::unordered_map<uint64_t, bool> m_pending_path_requests; // Whether the result is kept for polling
+    std::unordered_map<uint64_t, PathResult> m_path_results;
+    Utils::SequentialId<uint64_t> m_flow_field_id;
+    std::unordered_map<uint64_t, std::unique_ptr<FlowField>> m_flow_fields;
+    std::unordered_map<std::string, uint32_t> m_collision_categories;
+    std::optional<ActivityRegionOptions> m_activity_region;
+    std::unordered_set<uint64_t> m_activity_focus_body_ids;
+    std::vector<SDL_FRect> m_activity_rects;
+    std::vector<std::pair<uint64_t, bool>> m_activity_changes;
+    std::unordered_map<const Tiles::TileMapTileLayer *, TileLayerCollision> m_tile_layer_collisions;
+    AnimationTicker m_animation_ticker;
     b2BodyId m_followed_body_id;
+    bool m_has_pre_solve_shapes;
+    std::optional<uint64_t> m_simulated_frame; // The frame for which simulate has stepped the world
+    std::optional<uint64_t> m_stepped_frame; // The scene can be shown by several outlets in the same frame
     std::unique_ptr<Tiles::TileHeap> m_tile_heap_ptr;
     std::unique_ptr<Tiles::ObjectHeap> m_object_heap_ptr;
     std::unique_ptr<Tiles::TileMap> m_tile_map_ptr;
-    ActionAccumulator m_defers;
+    ActionQueue m_defers;
     Box2dDebugDraw * mp_box2d_debug_draw;
+    std::unique_ptr<Box2dTaskSystem> m_box2d_task_system_ptr;
 };
 
 inline float Scene::physicalToGraphical(float _value)
@@ -174,6 +372,25 @@ inline float Scene::graphicalToPhysical(float _value)
     return _value * m_meters_per_pixel;
 }
 
+inline Scene::BodyRenderProxy & Scene::getRenderProxy(b2BodyId _body_id)
+{
+    // Box2D keeps body indices dense, so they address the proxies directly
+    const size_t index = static_cast<size_t>(_body_id.index1 - 1);
+    if(index >= m_render_proxies.size())
+        m_render_proxies.resize(index + 1);
+    return m_render_proxies[index];
+}
+
+inline ContactRecord & Scene::appendContactRecord(ContactType _type, size_t & _count)
+{
+    // Records are reused between steps to keep the strings' storage
+    if(_count == m_contact_records.size())
+        m_contact_records.emplace_back();
+    ContactRecord & record = m_contact_records[_count++];
+    record.type = _type;
+    return record;
+}
+
 inline SDL_FPoint Scene::toAbsoluteCoords(float _world_x, float _world_y) const
 {
     return { .x = _world_x - m_world_offset.x, .y = _world_y - m_world_offset.y };
@@ -0,0 +1,78 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <Sol2D/World/BodyShapePhysicsDefinition.h>
+#include <Sol2D/MediaLayer/MediaLayer.h>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace Sol2D::World {
+
+struct RayCastQuery
+{
+    SDL_FPoint from;
+    SDL_FPoint to;
+};
+
+struct CircleCastGeometry
+{
+    float radius;
+};
+
+struct RectCastGeometry
+{
+    float w;
+    float h;
+};
+
+struct ShapeCastQuery
+{
+    std::variant<CircleCastGeometry, RectCastGeometry> geometry;
+    SDL_FPoint from;
+    SDL_FPoint to;
+};
+
+struct QueryOptions
+{
+    QueryOptions() :
+        is_parallel(false)
+    {
+    }
+
+    CollisionFilterDefinition filter;
+    bool is_parallel;
+};
+
+// The closest hit along a ray or a shape cast
+struct QueryHit
+{
+    uint64_t body_id;
+    std::string shape_key;
+    SDL_FPoint point;
+    SDL_FPoint normal;
+    float fraction;
+};
+
+using QueryHits = std::vector<std::optional<QueryHit>>;
+
+// Body IDs overlapping each rect
+using OverlapResults = std::vector<std::vector<uint64_t>>;
+
+} // namespace Sol2D::World
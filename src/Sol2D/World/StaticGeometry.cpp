@@ -0,0 +1,174 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <Sol2D/World/StaticGeometry.h>
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+using namespace Sol2D::World;
+
+namespace {
+
+constexpr float gc_rect_tolerance = 0.01f;
+
+// Box2D needs at least four points for a chain
+constexpr size_t gc_min_chain_point_count = 4;
+
+// Shorter segments are degenerate for Box2D, it is the Box2D linear slop
+constexpr float gc_min_segment_length = 0.005f;
+
+bool isNear(float _a, float _b)
+{
+    return std::abs(_a - _b) <= gc_rect_tolerance;
+}
+
+// Merges the rectangles of the same row, the rectangles must be sorted by the group, the row and the start
+template<bool is_horizontal>
+void mergeSortedStaticRects(std::vector<StaticRect> & _rects)
+{
+    auto start = [](const SDL_FRect & __rect) { return is_horizontal ? __rect.x : __rect.y; };
+    auto length = [](const SDL_FRect & __rect) { return is_horizontal ? __rect.w : __rect.h; };
+    auto rowStart = [](const SDL_FRect & __rect) { return is_horizontal ? __rect.y : __rect.x; };
+    auto rowLength = [](const SDL_FRect & __rect) { return is_horizontal ? __rect.h : __rect.w; };
+    size_t last = 0;
+    for(size_t i = 1; i < _rects.size(); ++i)
+    {
+        StaticRect & current = _rects[last];
+        const StaticRect & next = _rects[i];
+        const float end = start(current.rect) + length(current.rect);
+        if(current.group == next.group &&
+            isNear(rowStart(current.rect), rowStart(next.rect)) &&
+            isNear(rowLength(current.rect), rowLength(next.rect)) &&
+            start(next.rect) <= end + gc_rect_tolerance)
+        {
+            const float new_length = std::max(end, start(next.rect) + length(next.rect)) - start(current.rect);
+            if constexpr(is_horizontal)
+                current.rect.w = new_length;
+            else
+                current.rect.h = new_length;
+            continue;
+        }
+        _rects[++last] = next;
+    }
+    _rects.resize(last + 1);
+}
+
+} // namespace
+
+std::optional<SDL_FRect> Sol2D::World::tryMakeAxisAlignedRect(std::span<const SDL_FPoint> _points)
+{
+    if(_points.size() != 4)
+        return std::nullopt;
+    float min_x = _points[0].x, max_x = _points[0].x, min_y = _points[0].y, max_y = _points[0].y;
+    for(const SDL_FPoint & point : _points.subspan(1))
+    {
+        min_x = std::min(min_x, point.x);
+        max_x = std::max(max_x, point.x);
+        min_y = std::min(min_y, point.y);
+        max_y = std::max(max_y, point.y);
+    }
+    if(max_x - min_x <= gc_rect_tolerance || max_y - min_y <= gc_rect_tolerance)
+        return std::nullopt;
+    uint8_t corners = 0;
+    for(const SDL_FPoint & point : _points)
+    {
+        const bool is_left = isNear(point.x, min_x);
+        const bool is_top = isNear(point.y, min_y);
+        if((!is_left && !isNear(point.x, max_x)) || (!is_top && !isNear(point.y, max_y)))
+            return std::nullopt;
+        corners |= 1 << ((is_left ? 0 : 1) + (is_top ? 0 : 2));
+    }
+    if(corners != 0xF)
+        return std::nullopt;
+    return SDL_FRect { .x = min_x, .y = min_y, .w = max_x - min_x, .h = max_y - min_y };
+}
+
+// Adjacent and overlapping rectangles of the same height are merged into rows first, and then the rows of the same
+// width are merged into columns. It is not an optimal cover, but it is linear after sorting.
+void Sol2D::World::mergeStaticRects(std::vector<StaticRect> & _rects)
+{
+    if(_rects.size() < 2)
+        return;
+    std::sort(_rects.begin(), _rects.end(), [](const StaticRect & __a, const StaticRect & __b) {
+        return std::tie(__a.group, __a.rect.y, __a.rect.h, __a.rect.x) <
+            std::tie(__b.group, __b.rect.y, __b.rect.h, __b.rect.x);
+    });
+    mergeSortedStaticRects<true>(_rects);
+    std::sort(_rects.begin(), _rects.end(), [](const StaticRect & __a, const StaticRect & __b) {
+        return std::tie(__a.group, __a.rect.x, __a.rect.w, __a.rect.y) <
+            std::tie(__b.group, __b.rect.x, __b.rect.w, __b.rect.y);
+    });
+    mergeSortedStaticRects<false>(_rects);
+}
+
+// Loops are wound counterclockwise to make their normals point outwards.
+// Box2D uses the first and the last points of open chains as ghost vertices only, so the ghost vertices are added
+// to make all the segments collide. Open chains are one-sided: drawn from left to right, they collide on the upper side.
+// Sensors and short loops are made of separate two-sided segments.
+void Sol2D::World::createStaticChain(
+    b2BodyId _body_id,
+    const b2ShapeDef & _shape_def,
+    std::vector<b2Vec2> & _points,
+    bool _is_loop)
+{
+    _points.erase(
+        std::unique(_points.begin(), _points.end(), [](const b2Vec2 & __a, const b2Vec2 & __b) {
+            return b2DistanceSquared(__a, __b) < gc_min_segment_length * gc_min_segment_length;
+        }),
+        _points.end());
+    if(_is_loop && _points.size() > 2 &&
+        b2DistanceSquared(_points.front(), _points.back()) < gc_min_segment_length * gc_min_segment_length)
+    {
+        _points.pop_back();
+    }
+    if(_points.size() < (_is_loop ? 3 : 2))
+        return;
+    if(_is_loop)
+    {
+        float area = .0f;
+        for(size_t i = 0, j = _points.size() - 1; i < _points.size(); j = i++)
+            area += _points[j].x * _points[i].y - _points[i].x * _points[j].y;
+        if(area < .0f)
+            std::reverse(_points.begin(), _points.end());
+    }
+    if(_shape_def.isSensor || (_is_loop && _points.size() < gc_min_chain_point_count))
+    {
+        const size_t count = _is_loop ? _points.size() : _points.size() - 1;
+        for(size_t i = 0; i < count; ++i)
+        {
+            const b2Segment segment { .point1 = _points[i], .point2 = _points[(i + 1) % _points.size()] };
+            b2CreateSegmentShape(_body_id, &_shape_def, &segment);
+        }
+        return;
+    }
+    if(!_is_loop)
+    {
+        const b2Vec2 first_ghost = b2Sub(b2MulSV(2.0f, _points[0]), _points[1]);
+        const b2Vec2 last_ghost = b2Sub(b2MulSV(2.0f, _points[_points.size() - 1]), _points[_points.size() - 2]);
+        _points.insert(_points.begin(), first_ghost);
+        _points.push_back(last_ghost);
+    }
+    b2ChainDef chain_def = b2DefaultChainDef();
+    chain_def.userData = _shape_def.userData;
+    chain_def.points = _points.data();
+    chain_def.count = static_cast<int>(_points.size());
+    chain_def.friction = _shape_def.friction;
+    chain_def.restitution = _shape_def.restitution;
+    chain_def.filter = _shape_def.filter;
+    chain_def.isLoop = _is_loop;
+    b2CreateChain(_body_id, &chain_def);
+}
@@ -0,0 +1,38 @@
+// Sol2D Game Engine
+// Copyright (C) 2023-2025 Sergey Smolyannikov aka brainstream
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Lesser Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <Sol2D/MediaLayer/MediaLayer.h>
+#include <box2d/box2d.h>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace Sol2D::World {
+
+struct StaticRect
+{
+    SDL_FRect rect;
+    uint32_t group; // Only the rectangles of the same group are merged
+    uint32_t source; // The source of the first rectangle is kept after merging
+};
+
+std::optional<SDL_FRect> tryMakeAxisAlignedRect(std::span<const SDL_FPoint> _points);
+void mergeStaticRects(std::vector<StaticRect> & _rects);
+void createStaticChain(b2BodyId _body_id, const b2ShapeDef & _shape_def, std::vector<b2Vec2> & _points, bool _is_loop);
+
+} // namespace Sol2D::World